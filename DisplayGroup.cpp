@@ -0,0 +1,151 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         DisplayGroup.cpp
+ * Description:  Group of HT16K33 displays sharing one I2C bus
+ *
+ * This file is part of SevenSegment
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#include "DisplayGroup.h"
+
+
+//********
+// public
+//********
+
+DisplayGroup::DisplayGroup(uint16_t busKHz)
+{
+   busClock = busKHz ? busKHz : 100;
+}
+//----------------------------------------------------------
+
+bool DisplayGroup::add(ht16k33 &d)
+{
+   if (displayCount >= maxDisplays)   return false;
+
+   d.setAsync(true);
+   display[displayCount++] = &d;
+   return true;
+}
+//----------------------------------------------------------
+
+void DisplayGroup::begin()
+{
+   for (uint8_t i = 0; i < displayCount; i++)   display[i]->begin();
+}
+//----------------------------------------------------------
+
+void DisplayGroup::writeDisplay()
+{
+   for (uint8_t i = 0; i < displayCount; i++)   display[i]->writeDisplay();
+}
+//----------------------------------------------------------
+
+void DisplayGroup::setDisplayStatus(uint8_t s)
+{
+   for (uint8_t i = 0; i < displayCount; i++)   display[i]->setDisplayStatus(s);
+}
+//----------------------------------------------------------
+
+void DisplayGroup::setBlinkRate(uint8_t br)
+{
+   for (uint8_t i = 0; i < displayCount; i++)   display[i]->setBlinkRate(br);
+}
+//----------------------------------------------------------
+
+void DisplayGroup::setBrightness(uint8_t b)
+{
+   for (uint8_t i = 0; i < displayCount; i++)   display[i]->setBrightness(b);
+}
+//----------------------------------------------------------
+
+uint16_t DisplayGroup::update(uint16_t budget)
+{
+   uint16_t used = 0;
+   uint8_t  idle = 0;  // Displays in a row with nothing to send
+
+   while (idle < displayCount)
+   {
+      uint8_t maxBytes = 0xFF;
+
+      if (budget)
+      {
+         if (used >= budget)   break;
+         maxBytes = busBytes(budget - used);
+         if (maxBytes < 2)
+         {
+            if (used)   break;
+            maxBytes = 2;  // Always make some progress
+         }
+      }
+
+      uint8_t sent = display[nextDisplay]->service(maxBytes);
+      if (++nextDisplay >= displayCount)   nextDisplay = 0;
+
+      if (sent)
+      {
+         used += busTime(sent);
+         idle  = 0;
+      }
+      else
+         idle++;
+   }
+   return used;
+}
+//----------------------------------------------------------
+
+bool DisplayGroup::busy()
+{
+   for (uint8_t i = 0; i < displayCount; i++)
+      if (display[i]->busy())   return true;
+   return false;
+}
+//----------------------------------------------------------
+
+
+//*********
+// private
+//*********
+
+uint16_t DisplayGroup::busTime(uint8_t bytes)
+{
+   // Start, device address, the bytes and stop; 9 clocks per byte
+   uint32_t bits = (uint32_t)(bytes + 1) * 9 + 2;
+
+   return (bits * 1000) / busClock;
+}
+//----------------------------------------------------------
+
+uint8_t DisplayGroup::busBytes(uint16_t time)
+{
+   // Inverse of busTime(): the number of bytes that fit in 'time' microseconds
+   uint32_t bits = ((uint32_t)time * busClock) / 1000;
+
+   if (bits < 2 + 2 * 9)   return 0;
+   bits = (bits - 2) / 9 - 1;
+   return (bits > 0xFF) ? 0xFF : bits;
+}
+//----------------------------------------------------------
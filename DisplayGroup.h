@@ -0,0 +1,88 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         DisplayGroup.h
+ * Description:  Group of HT16K33 displays sharing one I2C bus
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage
+ *  A DisplayGroup drives up to 8 displays (addresses 0x70 to 0x77) together. The displays are put in
+ *  asynchronous mode: their writeDisplay(), setBrightness(), ... calls only queue the update, update()
+ *  sends the queued updates of all displays, within a bus time budget.
+ *
+ *  DisplayGroup group = DisplayGroup() or DisplayGroup(busKHz)
+ *     busKHz is the I2C bus clock, used to estimate the bus time. Default 100 kHz
+ *
+ *  add(display)
+ *     add a display (SevenSegment or any other ht16k33) to the group. Returns false if the group is full
+ *  begin()
+ *     initialise all displays in the group, see ht16k33::begin()
+ *  writeDisplay()
+ *     queue a display write for all displays, only the displays whose buffer changed will send anything
+ *  setDisplayStatus(s), setBlinkRate(br), setBrightness(b)
+ *     queue the setting for all displays
+ *  update(budget = 0)
+ *     send queued updates, round robin over the displays, for at most 'budget' microseconds of estimated
+ *     bus time. A budget of 0 sends everything. Returns the estimated bus time used in microseconds.
+ *     Large display updates are split to fit in the budget, but at least 1 transaction is sent.
+ *  busy()
+ *     true as long as any display has queued updates
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#ifndef DISPLAYGROUP_H
+#define DISPLAYGROUP_H
+
+#include <ht16k33.h>
+
+
+class DisplayGroup
+{
+   public:
+      static const uint8_t maxDisplays = 0x08;
+
+      DisplayGroup(uint16_t busKHz = 100);
+
+      bool add(ht16k33 &display);
+      void begin();
+      void writeDisplay();
+      void setDisplayStatus(uint8_t s);
+      void setBlinkRate(uint8_t br);
+      void setBrightness(uint8_t b);
+
+      uint16_t update(uint16_t budget = 0);
+      bool     busy();
+
+   private:
+      ht16k33 *display[maxDisplays];
+      uint8_t  displayCount = 0;
+      uint8_t  nextDisplay  = 0;   // Round robin, so no display starves
+      uint16_t busClock;           // in kHz
+
+      uint16_t busTime(uint8_t bytes);
+      uint8_t  busBytes(uint16_t time);
+};
+
+#endif // DISPLAYGROUP_H
@@ -33,8 +33,9 @@
  **********************************************************************************/
  
  #include "SevenSegment.h"
+#include "SevenSegmentFont.h"
 
-// Internally the diplaybuffer is used as follows:
+// Internally the diplaybuffer is used as follows (for the 4 digit display with colon):
 //  displaybuffer[0] = leftmost digit (MSD)
 //  displaybuffer[1] = second digit
 //  displaybuffer[2] = colon
@@ -47,205 +48,424 @@
 //  position 2 = third digit
 //  position 3 = rightmost digit
 
+// Other layouts are set up by SevenSegmentT: digits at or after the colon move up one raw position
+
 
 // Numbers from 0 to 9 or 0x0 to 0xF
-static const uint8_t numbertable[16] =
-{
-   0x3F, // 0
-   0x06, // 1
-   0x5B, // 2
-   0x4F, // 3
-   0x66, // 4
-   0x6D, // 5
-   0x7D, // 6
-   0x07, // 7
-   0x7F, // 8
-   0x6F, // 9
-   0x77, // a
-   0x7C, // b
-   0x39, // C
-   0x5E, // d
-   0x79, // E
-   0x71  // F
+static const uint8_t numbertable[16] = { SEVENSEGMENT_NUMBER_FONT };
+
+// Printable ASCII characters, 0x20 to 0x7F
+static const uint8_t asciitable[96] PROGMEM = { SEVENSEGMENT_ASCII_FONT };
+
+// Powers of 10, up to the largest one that fits in 32 bits
+static const uint32_t powersOf10[] =
+{
+   1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL
 };
+static const uint8_t  maxPowerOf10 = sizeof(powersOf10) / sizeof(powersOf10[0]) - 1;
+
+// The same in 64 bits, only for 64 bit numbers (SevenSegmentCanvas)
+static const uint64_t powersOf10_64[] PROGMEM =
+{
+   1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+   10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+   1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL,
+   10000000000000000000ULL
+};
+
+// 10^n for the type of 'value', n up to powerCount(value) - 1
+static uint8_t  powerCount(uint32_t)   { return maxPowerOf10 + 1; }
+static uint8_t  powerCount(uint64_t)   { return sizeof(powersOf10_64) / sizeof(powersOf10_64[0]); }
+static uint32_t powerOf10(uint8_t n, uint32_t)   { return powersOf10[n]; }
+static uint64_t powerOf10(uint8_t n, uint64_t)
+{
+   uint64_t power;
+   memcpy_P(&power, &powersOf10_64[n], sizeof(power));
+   return power;
+}
 
 
 //********
 // public
 //********
 
-SevenSegment::SevenSegment(uint8_t i2c_addr)
+SevenSegmentBase::SevenSegmentBase(uint8_t i2c_addr, uint8_t digits, uint8_t colonPos)
+   : ht16k33(i2c_addr), digitCount(digits), colonPosition(colonPos)
 {
+   // Only the rows holding a digit or the colon are sent
+   displayRows = rawPos(digitCount - 1) + 1;
+   if ((colonPosition != noColon) && (colonPosition >= displayRows))   displayRows = colonPosition + 1;
 }
 //----------------------------------------------------------
 
-void SevenSegment::writeDisplay()
+uint8_t SevenSegmentBase::digits()
+{
+   return digitCount;
+}
+//----------------------------------------------------------
+
+void SevenSegmentBase::writeDisplay()
 {
    ht16k33::writeDisplay();
 }
 //----------------------------------------------------------
 
-void SevenSegment::writeColon()
+void SevenSegmentBase::writeColon()
 {
-   Wire.beginTransmission(i2c_address);
-   Wire.write(colonPosition << 1); // start at address $02
+   if (colonPosition == noColon)   return;
+   writeRange(colonPosition << 1, (colonPosition << 1) + 1);  // 2 bytes per raw position
+}
+//----------------------------------------------------------
 
-   Wire.write(displaybuffer[colonPosition] & 0xFF);
-   Wire.write(displaybuffer[colonPosition] >> 8);  // No high byte
+void SevenSegmentBase::drawColon(bool status)
+{
+   if (colonPosition == noColon)   return;
+   drawbuffer[colonPosition] = status ? colonCode : emptyCode;
+}
+//----------------------------------------------------------
 
-   Wire.endTransmission();
+void SevenSegmentBase::toggleColon()
+{
+   if (colonPosition == noColon)   return;
+   drawbuffer[colonPosition] = drawbuffer[colonPosition] ? emptyCode : colonCode;
 }
 //----------------------------------------------------------
 
-void SevenSegment::drawColon(bool status)
+#ifdef HT16K33_ISR_INDICATORS
+void SevenSegmentBase::isrDrawColon(bool status)
 {
-   displaybuffer[colonPosition] = status ? colonCode : emptyCode;
+   if (colonPosition == noColon)   return;
+   overlayWrite(colonPosition, colonCode, status ? colonCode : emptyCode);
 }
 //----------------------------------------------------------
 
-void SevenSegment::toggleColon()
+void SevenSegmentBase::isrToggleColon()
 {
-   displaybuffer[colonPosition] = displaybuffer[colonPosition] ? emptyCode : colonCode;
+   if (colonPosition == noColon)   return;
+   overlayToggle(colonPosition, colonCode);
 }
 //----------------------------------------------------------
 
-void SevenSegment::drawDigit(uint8_t pos, uint8_t value, bool dot)
+void SevenSegmentBase::isrDrawDot(uint8_t pos, bool dot)
 {
-   writeDigitRawPos(pos, ((value <= 0x0F) ? numbertable[value] : emptyCode) | (dot ? dotCode : emptyCode));
+   if (pos >= digitCount)   return;
+   overlayWrite(rawPos(pos), dotCode, dot ? dotCode : emptyCode);
 }
 //----------------------------------------------------------
 
-void SevenSegment::clearDigit(uint8_t pos)
+void SevenSegmentBase::isrToggleDot(uint8_t pos)
+{
+   if (pos >= digitCount)   return;
+   overlayToggle(rawPos(pos), dotCode);
+}
+//----------------------------------------------------------
+#endif
+
+void SevenSegmentBase::drawDigit(uint8_t pos, uint8_t value, bool dot)
+{
+   if (pos >= digitCount)   return;
+   drawDigitRaw(rawPos(pos), value, dot);
+}
+//----------------------------------------------------------
+
+void SevenSegmentBase::clearDigit(uint8_t pos)
 {
    writeDigitRawPos(pos, emptyCode);
 }
 //----------------------------------------------------------
 
-void SevenSegment::clearDigits()
+void SevenSegmentBase::clearDigits()
 {
    // Clear all digits, leave the colon alone
-   for (int i = 0; i < displayDigits; i++)  clearDigit(i);
+   for (int i = 0; i < digitCount; i++)  clearDigit(i);
+}
+//----------------------------------------------------------
+
+void SevenSegmentBase::drawDot(uint8_t pos, bool dot)
+{
+   if (pos >= digitCount)   return;
+   drawDotRaw(rawPos(pos), dot);
+}
+//----------------------------------------------------------
+
+void SevenSegmentBase::toggleDot(uint8_t pos)
+{
+   if (pos >= digitCount)   return;
+   pos = rawPos(pos);  // convert to raw position
+   drawDotRaw(pos, !(drawbuffer[pos] & dotCode));
 }
 //----------------------------------------------------------
 
-void SevenSegment::drawDot(uint8_t pos, bool dot)
+void SevenSegmentBase::drawSegments(uint8_t pos, uint8_t segments)
 {
-   if (pos > (displaybufSize - 1))   return;
-   if (pos >= colonPosition)  pos ++;  // convert to raw position
-   writeDigitRaw(pos, (displaybuffer[pos] & 0x7F) | (dot ? dotCode : emptyCode));
+   writeDigitRawPos(pos, segments);
 }
 //----------------------------------------------------------
 
-void SevenSegment::toggleDot(uint8_t pos)
+uint8_t SevenSegmentBase::blit(const uint8_t *segments, uint8_t n, uint8_t startPos)
 {
-   if (pos > (displaybufSize - 1))   return;
-   if (pos >= colonPosition)  pos ++;  // convert to raw position
-   writeDigitRaw(pos, (displaybuffer[pos] & 0x7F) | ((displaybuffer[pos] & dotCode) ? emptyCode : dotCode));
+   return copySegments(segments, n, startPos, false);
 }
 //----------------------------------------------------------
 
-void SevenSegment::drawHyphen(uint8_t pos)
+uint8_t SevenSegmentBase::blit_P(const uint8_t *segments, uint8_t n, uint8_t startPos)
+{
+   return copySegments(segments, n, startPos, true);
+}
+//----------------------------------------------------------
+
+uint8_t SevenSegmentBase::readRaw(uint8_t *segments, uint8_t n, uint8_t startPos)
+{
+   if (startPos >= digitCount)   return 0;
+   if (n > digitCount - startPos)   n = digitCount - startPos;
+
+   for (uint8_t i = 0; i < n; i++)   segments[i] = drawbuffer[rawPos(startPos + i)];
+   return n;
+}
+//----------------------------------------------------------
+
+bool SevenSegmentBase::drawBar(uint8_t length)
+{
+   bool fits = (length <= 2 * digitCount);
+
+   for (uint8_t i = 0; i < digitCount; i++, length = (length > 2) ? length - 2 : 0)
+      drawbuffer[rawPos(i)] = (length >= 2) ? (barLeft | barRight) : (length ? barLeft : emptyCode);
+   return fits;
+}
+//----------------------------------------------------------
+
+void SevenSegmentBase::blankDigits(uint8_t digits)
+{
+   uint8_t rows = 0x00;
+
+   for (uint8_t i = 0; i < digitCount; i++)
+      if (digits & (1 << i))   rows |= (1 << rawPos(i));
+   setBlankRows(rows);
+}
+//----------------------------------------------------------
+
+void SevenSegmentBase::drawHyphen(uint8_t pos)
 {
    writeDigitRawPos(pos, hyphenCode);
 }
 //----------------------------------------------------------
 
-void SevenSegment::drawOver(uint8_t pos)
+void SevenSegmentBase::drawOver(uint8_t pos)
 {
    writeDigitRawPos(pos, overCode);
 }
 //----------------------------------------------------------
 
-void SevenSegment::drawUnder(uint8_t pos)
+void SevenSegmentBase::drawUnder(uint8_t pos)
 {
    writeDigitRawPos(pos, underCode);
 }
 //----------------------------------------------------------
 
-void SevenSegment::drawLineUpper()
+void SevenSegmentBase::drawLineUpper()
 {
-   for (uint8_t i = 0; i < displayDigits; i++) 
+   for (uint8_t i = 0; i < digitCount; i++) 
       writeDigitRawPos(i, overCode);
 }
 //----------------------------------------------------------
 
-void SevenSegment::drawLineMiddle()
+void SevenSegmentBase::drawLineMiddle()
 {
-   for (uint8_t i = 0; i < displayDigits; i++) 
+   for (uint8_t i = 0; i < digitCount; i++) 
       writeDigitRawPos(i, hyphenCode);
 }
 //----------------------------------------------------------
 
-void SevenSegment::drawLineLower()
+void SevenSegmentBase::drawLineLower()
 {
-   for (uint8_t i = 0; i < displayDigits; i++) 
+   for (uint8_t i = 0; i < digitCount; i++) 
       writeDigitRawPos(i, underCode);
 }
 //----------------------------------------------------------
 
-void SevenSegment::drawLines2()
+void SevenSegmentBase::drawLines2()
 {
-   for (uint8_t i = 0; i < displayDigits; i++) 
+   for (uint8_t i = 0; i < digitCount; i++) 
       writeDigitRawPos(i, overCode | underCode);
 }
 //----------------------------------------------------------
 
-void SevenSegment::drawLines3()
+void SevenSegmentBase::drawLines3()
 {
-   for (uint8_t i = 0; i < displayDigits; i++) 
+   for (uint8_t i = 0; i < digitCount; i++) 
       writeDigitRawPos(i, overCode | hyphenCode | underCode);
 }
 //----------------------------------------------------------
 
-bool SevenSegment::printNumber(int32_t number, uint8_t base, bool padding)
+bool SevenSegmentBase::printNumber(int32_t number, uint8_t base, bool padding)
+{
+   return printNumberAt(0, digitCount, number, base, padding);
+}
+//----------------------------------------------------------
+
+bool SevenSegmentBase::printNumberAt(uint8_t pos, uint8_t width, int32_t number, uint8_t base, bool padding)
 {
-   int8_t i = displayDigits - 1;
-   bool   lastDigitFree = false;
-   bool   negative = (number < 0);
+   uint8_t  segments[bufferSize];
+   bool     negative = (number < 0);
+   uint32_t value    = negative ? 0 - (uint32_t)number : number;  // Don't complicate things, work with positive numbers
+
+   if (pos >= digitCount)   return false;
+   if (width > digitCount - pos)   width = digitCount - pos;
+   if (width == 0)   return false;
+
+   bool fits = formatNumber(segments, width, value, negative, base, padding);
+   copySegments(segments, width, pos, false);
+   return fits;
+}
+//----------------------------------------------------------
 
+bool SevenSegmentBase::printTime(uint8_t first, uint8_t last)
+{
    clearDigits();
-   if ((base <= 1) || (base > HEX))  return false;
-   if (negative)   number = -number;  // Don't complicate things, work with positive numbers
-   do
+   if ((first > 99) || (last > 99))  return false;  // 99:99 is the highest allowed
+
+   drawDigit(0, first / 10);
+   drawDigit(1, first % 10);
+   drawDigit(2, last / 10);
+   drawDigit(3, last % 10);
+   return true;
+}
+//----------------------------------------------------------
+
+
+bool SevenSegmentBase::printFixed(int32_t value, uint8_t decimals)
+{
+   return printFixedAt(0, digitCount, value, decimals);
+}
+//----------------------------------------------------------
+
+bool SevenSegmentBase::printFixedAt(uint8_t pos, uint8_t width, int32_t value, uint8_t decimals)
+{
+   uint8_t  digit[bufferSize];
+   bool     negative  = (value < 0);
+   uint32_t magnitude = negative ? 0 - (uint32_t)value : value;
+
+   if (pos >= digitCount)   return false;
+   if (width > digitCount - pos)   width = digitCount - pos;
+   if ((decimals == 0) || (width == 0))   return printNumberAt(pos, width, value);
+
+   // Drop decimals, rounding, until there is a digit before the dot and room for the sign
+   uint32_t rounded = magnitude;
+   uint8_t  dropped = 0;
+   while ((decimals > dropped) &&
+          ((decimals - dropped >= width - negative) || !splitNumber(rounded, DEC, digit, width - negative)))
    {
-      if ((i == 0) && (number == 0))   lastDigitFree = true;
-      drawDigit(i-- , number % base);
-      number /= base;
-   } while (((number != 0) || padding) && (i >= 0));
+      // Any 32 bit value rounds to 0 when more than 9 decimals are dropped
+      dropped++;
+      rounded = (dropped > maxPowerOf10) ? 0 : (magnitude + powersOf10[dropped] / 2) / powersOf10[dropped];
+   }
+   magnitude = rounded;
+   decimals -= dropped;
+   if (decimals == 0)   return printNumberAt(pos, width, negative ? -(int32_t)magnitude : (int32_t)magnitude);
 
-   if (i >= 0)   lastDigitFree = true;
+   for (uint8_t i = 0; i < width; i++)   clearDigit(pos + i);
+   splitNumber(magnitude, DEC, digit, width);
 
-   // Check for overflow
-   if (number != 0)
+   // Leading zeros are not drawn, but there is always a digit before the dot
+   uint8_t dotPos = width - 1 - decimals;
+   uint8_t first  = 0;
+   while ((first < dotPos) && (digit[first] == 0))   first++;
+   for (uint8_t i = first; i < width; i++)
+      drawDigit(pos + i, digit[i], i == dotPos);
+
+   if (negative)   drawHyphen(pos);
+   return true;
+}
+//----------------------------------------------------------
+
+bool SevenSegmentBase::printFloat(float value, uint8_t maxDecimals)
+{
+   bool negative = (value < 0);
+
+   if (value != value)
    {
-      if (negative)
-         drawLineLower();
-      else
-         drawLineUpper();
+      // Not a number
+      clearDigits();
+      drawLineMiddle();
       return false;
    }
 
-   // Draw sign: on first digit if there is place, or put a dot at the end of the last digit
-   // so -123 is displayed as -123 while -1234 is displayed as 1234.
-   if (negative)
-      if (lastDigitFree)
-         drawHyphen(0);
-      else
-         drawDot(displayDigits - 1);
+   // Use the most decimals that still fit
+   if (maxDecimals > digitCount - 1)   maxDecimals = digitCount - 1;
+   for (int8_t decimals = maxDecimals; decimals >= 0; decimals--)
+   {
+      float scaled = value * powersOf10[decimals];
+      float limit  = powersOf10[digitCount - (negative && decimals)] - 0.5f;  // Without decimals -1234 is 1234.
 
-   return true;
+      if ((scaled < limit) && (scaled > -limit))
+         return printFixed((int32_t)(scaled + (negative ? -0.5f : 0.5f)), decimals);
+   }
+
+   return printNumber(negative ? INT32_MIN : INT32_MAX);  // Overflow or underflow
 }
 //----------------------------------------------------------
 
-bool SevenSegment::printTime(uint8_t first, uint8_t last)
+bool SevenSegmentBase::printString(const char *text)
 {
+   uint8_t pos = 0;
+
    clearDigits();
-   if ((first > 99) || (last > 99))  return false;  // 99:99 is the highest allowed
+   while (*text && (pos < digitCount))
+      writeDigitRawPos(pos++, nextGlyph(text));
 
-   drawDigit(0, first / 10);
-   drawDigit(1, first % 10);
-   drawDigit(2, last / 10);
-   drawDigit(3, last % 10);
+   return *text == 0;
+}
+//----------------------------------------------------------
+
+void SevenSegmentBase::scrollLeft(uint8_t segments)
+{
+   // Move all digits one position to the left, the colon stays
+   for (uint8_t i = 0; i + 1 < digitCount; i++)
+      drawbuffer[rawPos(i)] = drawbuffer[rawPos(i + 1)];
+   drawbuffer[rawPos(digitCount - 1)] = segments;
+}
+//----------------------------------------------------------
+
+uint8_t SevenSegmentBase::glyph(char c)
+{
+   if (((uint8_t)c < 0x20) || ((uint8_t)c > 0x7F))   return emptyCode;
+   return pgm_read_byte(&asciitable[(uint8_t)c - 0x20]);
+}
+//----------------------------------------------------------
+
+uint8_t SevenSegmentBase::nextGlyph(const char *&text, bool inFlash)
+{
+   // The glyph of the next character, a '.' following it is added as its dot
+   uint8_t segments = glyph(readChar(text++, inFlash));
+
+   if ((readChar(text, inFlash) == '.') && !(segments & dotCode))
+   {
+      segments |= dotCode;
+      text++;
+   }
+   return segments;
+}
+//----------------------------------------------------------
+
+char SevenSegmentBase::readChar(const char *text, bool inFlash)
+{
+   return inFlash ? (char)pgm_read_byte(text) : *text;
+}
+//----------------------------------------------------------
+
+//***********
+// protected
+//***********
+
+void SevenSegmentBase::drawDigitRaw(uint8_t rawpos, uint8_t value, bool dot)
+{
+   drawbuffer[rawpos] = ((value <= 0x0F) ? numbertable[value] : emptyCode) | (dot ? dotCode : emptyCode);
+}
+//----------------------------------------------------------
+
+void SevenSegmentBase::drawDotRaw(uint8_t rawpos, bool dot)
+{
+   drawbuffer[rawpos] = (drawbuffer[rawpos] & 0x7F) | (dot ? dotCode : emptyCode);
 }
 //----------------------------------------------------------
 
@@ -254,17 +474,121 @@ bool SevenSegment::printTime(uint8_t first, uint8_t last)
 // Private
 //*********
 
-void SevenSegment::writeDigitRaw(uint8_t rawpos, uint8_t bitmask)
+template <typename T> bool SevenSegmentBase::splitNumber(T value, uint8_t base, uint8_t *digit, uint8_t count)
+{
+   // Split value in count digits, most significant first. Returns false if it doesn't fit
+   // Division on an 8-bit processor is slow, so avoid it for the common bases
+
+   if (base == DEC)
+   {
+      // Subtract powers of 10, at most 9 times per digit. Digits above the largest power are 0
+      uint8_t powers = powerCount(value);
+
+      if ((count < powers) && (value >= powerOf10(count, value)))   return false;
+      for (uint8_t i = 0; i < count; i++)
+      {
+         uint8_t n = count - 1 - i;
+         uint8_t d = 0;
+
+         if (n < powers)
+         {
+            T power = powerOf10(n, value);
+            while (value >= power)
+            {
+               value -= power;
+               d++;
+            }
+         }
+         digit[i] = d;
+      }
+      return true;
+   }
+
+   if ((base & (base - 1)) == 0)
+   {
+      // Powers of 2: shift and mask
+      uint8_t shift = 0;
+      while ((1 << shift) < base)   shift++;
+
+      for (uint8_t i = count; i-- > 0; )
+      {
+         digit[i] = value & (base - 1);
+         value >>= shift;
+      }
+      return value == 0;
+   }
+
+   for (uint8_t i = count; i-- > 0; )
+   {
+      digit[i] = value % base;
+      value /= base;
+   }
+   return value == 0;
+}
+//----------------------------------------------------------
+
+template <typename T> bool SevenSegmentBase::formatNumber(uint8_t *segments, uint8_t width, T magnitude, bool negative,
+                                                          uint8_t base, bool padding)
+{
+   // The segments printNumber() draws in a field of 'width' digits. Returns false if the number doesn't fit,
+   // the segments are then an overflow or underflow line, or empty if the base is not valid
+   uint8_t *digit = segments;  // Each digit is replaced by its segments
+
+   if ((base <= 1) || (base > HEX))
+   {
+      for (uint8_t i = 0; i < width; i++)   segments[i] = emptyCode;
+      return false;
+   }
+
+   // Check for overflow
+   if (!splitNumber(magnitude, base, digit, width))
+   {
+      for (uint8_t i = 0; i < width; i++)   segments[i] = negative ? underCode : overCode;
+      return false;
+   }
+
+   // Draw sign: on first digit if there is place, or put a dot at the end of the last digit
+   // so -123 is displayed as -123 while -1234 is displayed as 1234.
+   bool signFirst = negative && (digit[0] == 0);
+
+   // Leading zeros are only drawn when padding, the last digit is always drawn
+   uint8_t first = 0;
+   if (!padding)
+      while ((first < width - 1) && (digit[first] == 0))   first++;
+   for (uint8_t i = 0; i < width; i++)
+      segments[i] = (i < first) ? emptyCode : numbertable[digit[i]];
+
+   if (signFirst)
+      segments[0] = hyphenCode;
+   else if (negative)
+      segments[width - 1] |= dotCode;
+   return true;
+}
+//----------------------------------------------------------
+
+template bool SevenSegmentBase::splitNumber<uint32_t>(uint32_t, uint8_t, uint8_t *, uint8_t);
+template bool SevenSegmentBase::splitNumber<uint64_t>(uint64_t, uint8_t, uint8_t *, uint8_t);
+template bool SevenSegmentBase::formatNumber<uint32_t>(uint8_t *, uint8_t, uint32_t, bool, uint8_t, bool);
+template bool SevenSegmentBase::formatNumber<uint64_t>(uint8_t *, uint8_t, uint64_t, bool, uint8_t, bool);
+//----------------------------------------------------------
+
+void SevenSegmentBase::writeDigitRawPos(uint8_t pos, uint8_t bitmask)
 {
-  if (rawpos > displaybufSize)   return;
-  displaybuffer[rawpos] = bitmask;
+   if (pos >= digitCount)   return;
+   drawSegmentsRaw(rawPos(pos), bitmask);
 }
 //----------------------------------------------------------
 
-void SevenSegment::writeDigitRawPos(uint8_t pos, uint8_t bitmask)
+uint8_t SevenSegmentBase::copySegments(const uint8_t *segments, uint8_t n, uint8_t startPos, bool inFlash)
 {
-   if (pos > (displaybufSize -1))   return;
-   if (pos >= colonPosition)  pos ++;  // convert to raw position
-   displaybuffer[pos] = bitmask;
+   // Clip once, then copy without checks per digit
+   if (startPos >= digitCount)   return 0;
+   if (n > digitCount - startPos)   n = digitCount - startPos;
+
+   if (inFlash)
+      for (uint8_t i = 0; i < n; i++)   drawbuffer[rawPos(startPos + i)] = pgm_read_byte(segments + i);
+   else
+      for (uint8_t i = 0; i < n; i++)   drawbuffer[rawPos(startPos + i)] = segments[i];
+   return n;
 }
 //----------------------------------------------------------
@@ -19,8 +19,21 @@
  *   The display has 4 digits and a colon: 00:00, with optional dots after each digit
  *   You can retrieve the number of digits from the constant SevenSegment::displayDigits
  *   The positions for the display range from 0 (leftmost digit) to 3 (rightmost digit)
+ *
+ *   Other layouts are available as SevenSegmentT<digits, colonPosition>, checked at compile time:
+ *      SevenSegment          SevenSegmentT<4, 2>, 4 digits with a colon between the 2nd and 3rd digit
+ *      SevenSegment8         SevenSegmentT<8>, 8 digits without a colon
+ *   colonPosition is the position of the digit following the colon, leave it out if there is no colon
+ *   On a SevenSegmentT the position of drawDigit(), clearDigit(), drawDot() and drawSegments() can also be
+ *   given as a template argument, it is then checked at compile time: display.drawDigit<3>(value)
+ *   Only these 4 methods fold their check and position mapping at compile time, and only when called on the
+ *   SevenSegmentT itself. All other methods (print, lines, text, blit) and every helper that holds a
+ *   SevenSegmentBase& (SevenSegmentCanvas, SevenSegmentClock, SevenSegmentCounter, SevenSegmentMarquee,
+ *   SevenSegmentPager, SevenSegmentAnimation, SevenSegmentDimmer) check and map positions at run time
+ *   digits() returns the number of digits of any display, see also SevenSegmentCanvas.h to combine displays
  * 
  *   There are only 2 methods that will actually change the display contents: writeDisplay() and writeColon()
+ *   (in asynchronous mode they queue the update, see ht16k33.h)
  *   All other methods work on an internal buffer
  *   
  *  Initialise with SevenSegment display = SevenSegment() or SevenSegment display = SevenSegment(device_address).
@@ -30,13 +43,14 @@
  * ~~~~~~~~~~~~~~~~~~~~
  *   writeDisplay()
  *      write the buffer contents to the display. You need to call this function to display anything
+ *      Only the digits that changed since the previous write are sent to the display
  *   writeColon()
  * 	    write only the colon to ths display. This function does not change the status of the colon.
  *
  *  Clearing the display
  * ~~~~~~~~~~~~~~~~~~~~~~
  *   clearDisplay()
- * 	    clear the whole display buffer, including the colon. Note that only the buffer is cleared
+ * 	    clear the whole display buffer, including the colon. Note that only the buffer is cleared, call writeDisplay() to show it
  *   clearDigits()
  *      clear the digits, but leave the colon alone. Note that only the buffer is cleared
  *
@@ -50,6 +64,27 @@
  *      draw a dot at position 'pos', leaving the digit at that position alone
  *   toggleDot(pos)
  *      toggle the dot at position 'pos', leaving the digit at that position alone
+ *   drawSegments(pos, segments)
+ *      draw any combination of segments at position 'pos': bit 0 to 6 are segment a to g, bit 7 is the dot
+ *   blankDigits(digits)
+ *      digits is a bit mask of positions (bit 0 is position 0) that are written as empty, the buffer is not
+ *      changed. Only the digits that change are written. See SevenSegmentDimmer.h
+ *
+ *  Bulk segment access
+ * ~~~~~~~~~~~~~~~~~~~~~
+ *   blit(segments, n, startPos = 0)
+ *      draw n segment bytes (as in drawSegments()) from position 'startPos' on, in one pass.
+ *      Bytes that don't fit are ignored. Returns the number of digits drawn
+ *   blit_P(segments, n, startPos = 0)
+ *      the same, with the segments in flash (PROGMEM)
+ *   readRaw(segments, n, startPos = 0)
+ *      copy the segments of n digits from position 'startPos' on into 'segments'. Returns the number copied
+ *   drawBar(length)
+ *      draw a bar graph from the left, in steps of half a digit (the left or right vertical segments).
+ *      Returns false if length is longer than 2 * digits(), the full bar is drawn then
+ *   show(frame, startPos = 0)
+ *   show_P(frame, startPos = 0)
+ *      draw a SevenSegmentFrame in RAM or in flash, built at compile time. See SevenSegmentFrame.h
  *
  *  Colon handling
  * ~~~~~~~~~~~~~~~~
@@ -58,6 +93,19 @@
  *  toggleColon()
  *     toggle the colon
  *
+ *  Indicators from an interrupt
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  Only available with the build flag HT16K33_ISR_INDICATORS, see ht16k33.h.
+ *  These may be called from an interrupt routine, they never disable interrupts and never use I2C.
+ *  They are shown on top of what is drawn: isrDrawDot(pos, false) only removes a dot drawn with isrDrawDot().
+ *  Only one interrupt routine may use them. The change is sent by the next service() from loop().
+ *  isrDrawColon(status = true)
+ *  isrToggleColon()
+ *     draw, remove or toggle the colon
+ *  isrDrawDot(pos, dot = true)
+ *  isrToggleDot(pos)
+ *     draw, remove or toggle the dot of the digit at position 'pos'
+ *
  *  Hypen, Over(flow) and Under(flow)
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  *  drawHyphen(pos)
@@ -85,8 +133,34 @@
  *     negative numbers are preceded by a '-' at the first postion, unless the number is 4 digits, then the last dot will be set
  *        so -123 will be displayed as "-123", while -1234 will be displayed as "1234."
  *     if padding is true the number will be padded with zeros: "0001" or "-001"
+ *  printNumberAt(pos, width, number, base = 10, padding = false)
+ *     print a number in the field of 'width' digits starting at position 'pos', the other digits are not changed
  *  printTime(first, last)
  *     print a time (or a date), where first is displayed in the first 2 digits and last in the last 2. The colon is not changed.
+ *  printFixed(value, decimals)
+ *     print value / 10^decimals, so printFixed(-56, 2) displays "-0.56". If there are not enough digits, decimals are
+ *     dropped with rounding; if even the integer part doesn't fit an overflow or underflow is displayed.
+ *     Negative numbers are preceded by a '-' at the first position. With 0 decimals this is printNumber(value)
+ *  printFixedAt(pos, width, value, decimals)
+ *     print a fixed point value in the field of 'width' digits starting at position 'pos'
+ *  printFloat(value, maxDecimals = 3)
+ *     print a float with as many decimals as fit, up to maxDecimals. Does not need any of the float formatting code
+ *     NaN is displayed as a line in the middle
+ *
+ *  Text
+ * ~~~~~~
+ *  printString(text)
+ *     print text from the leftmost digit. Characters that can't be displayed are left blank, a '.' is drawn
+ *     as the dot of the character before it. Returns false if the text didn't fit
+ *  glyph(c)
+ *     the segments for character c
+ *  scrollLeft(segments)
+ *     move all digits one position to the left (the colon stays) and draw 'segments' in the rightmost digit,
+ *     see SevenSegmentMarquee.h to scroll a text
+ *
+ *  Counters
+ * ~~~~~~~~~~
+ *  See SevenSegmentCounter.h for a counter or a MM:SS timer that only draws the digits that change
  *
  *   Display control    These functions have an immediate effect
  * ~~~~~~~~~~~~~~~~~~
@@ -95,6 +169,8 @@
  *  setBlinkRate(br)
  *     set the display blinkrate: SevenSegment::blink_Off, SevenSegment::blink_2Hz, SevenSegment::blink_1Hz or SevenSegment::blink_0_5Hz
  *     for no blinking, 2Hz, 1Hz or 0.5Hz
+ *  blinkRate()
+ *     the blink rate set with setBlinkRate()
  *  setBrightness(b)
  *     set the display brightness, from SevenSegment::minBrightness to SevenSegment::maxBrightness
  *
@@ -123,12 +199,38 @@
 #include <Wire.h>
 #include <ht16k33.h>
 
-class SevenSegment : public ht16k33
+template <uint8_t Digits> struct SevenSegmentFrame;  // See SevenSegmentFrame.h
+
+
+// Compile time helpers for the display geometry
+namespace SevenSegmentLayout
+{
+   // Digits at or after the colon move up one raw position
+   constexpr uint8_t rawPosition(uint8_t pos, uint8_t colonPos)
+   {
+      return (pos >= colonPos) ? pos + 1 : pos;
+   }
+}
+
+
+// Timing of the helpers that are called from loop(), in ms or us and wrapping around
+namespace SevenSegmentTiming
+{
+   // Move 'next' on by 'interval': a fixed rate, unless we are more than an interval behind
+   inline void advance(uint32_t &next, uint32_t interval, uint32_t now)
+   {
+      next += interval;
+      if ((int32_t)(now - next) >= 0)   next = now + interval;
+   }
+}
+
+
+class SevenSegmentBase : public ht16k33
 {
    public:
-      static const uint8_t displayDigits = 0x04;
+      static const uint8_t noColon = 0xFF;
 
-      SevenSegment(uint8_t i2c_addr = defaultI2C_address);
+      uint8_t digits();
       void writeDisplay();
 
       // Raw digit handling
@@ -137,12 +239,37 @@ class SevenSegment : public ht16k33
       void clearDigit(uint8_t pos);
       void drawDot(uint8_t pos, bool dot = true);
       void toggleDot(uint8_t pos);
+      void drawSegments(uint8_t pos, uint8_t segments);
+      void blankDigits(uint8_t digits);
+
+      // Bulk segment access
+      uint8_t blit(const uint8_t *segments, uint8_t n, uint8_t startPos = 0);
+      uint8_t blit_P(const uint8_t *segments, uint8_t n, uint8_t startPos = 0);
+      uint8_t readRaw(uint8_t *segments, uint8_t n, uint8_t startPos = 0);
+      bool    drawBar(uint8_t length);
+
+      template <uint8_t Digits> uint8_t show(const SevenSegmentFrame<Digits> &frame, uint8_t startPos = 0)
+      {
+         return blit(frame.segments, Digits, startPos);
+      }
+      template <uint8_t Digits> uint8_t show_P(const SevenSegmentFrame<Digits> &frame, uint8_t startPos = 0)
+      {
+         return blit_P(frame.segments, Digits, startPos);
+      }
 
       // Colon related
       void writeColon();
       void drawColon(bool status = true);
       void toggleColon();
 
+#ifdef HT16K33_ISR_INDICATORS
+      // Indicators, safe to call from one interrupt routine
+      void isrDrawColon(bool status = true);
+      void isrToggleColon();
+      void isrDrawDot(uint8_t pos, bool dot = true);
+      void isrToggleDot(uint8_t pos);
+#endif
+
       // Hypen, Over(flow) and Under(flow)
       void drawHyphen(uint8_t pos);
       void drawOver(uint8_t pos);
@@ -155,22 +282,125 @@ class SevenSegment : public ht16k33
 
       // Print functions
       bool printNumber(int32_t number, uint8_t base = 10, bool padding = false);
+      bool printNumberAt(uint8_t pos, uint8_t width, int32_t number, uint8_t base = 10, bool padding = false);
       bool printTime(uint8_t first, uint8_t last);
+      bool printFixed(int32_t value, uint8_t decimals);
+      bool printFixedAt(uint8_t pos, uint8_t width, int32_t value, uint8_t decimals);
+      bool printFloat(float value, uint8_t maxDecimals = 3);
+
+      // Text
+      bool printString(const char *text);
+      void scrollLeft(uint8_t segments);
+      static uint8_t glyph(char c);
+
+   protected:
+      SevenSegmentBase(uint8_t i2c_addr, uint8_t digits, uint8_t colonPos);
+
+      // Drawing at a raw position, without checks
+      void drawDigitRaw(uint8_t rawpos, uint8_t value, bool dot);
+      void drawDotRaw(uint8_t rawpos, bool dot);
+      void drawSegmentsRaw(uint8_t rawpos, uint8_t segments)   { drawbuffer[rawpos] = segments; }
 
    private:
+      friend class SevenSegmentMarquee;
+      friend class SevenSegmentCounter;
+      friend class SevenSegmentCanvas;
+
       static const uint8_t emptyCode  = 0x00;
       static const uint8_t hyphenCode = 0x40;
       static const uint8_t overCode   = 0x01;
       static const uint8_t underCode  = 0x08;
       static const uint8_t dotCode    = 0x80;
       static const uint8_t colonCode  = 0x02;  // Only valid at colonPosition
+      static const uint8_t barLeft    = 0x30;  // Segments e and f
+      static const uint8_t barRight   = 0x06;  // Segments b and c
+
+      const uint8_t  digitCount;      // Number of digits
+      const uint8_t  colonPosition;   // Raw position of the colon, noColon if there is none
 
-      static const uint8_t displaybufSize = displayDigits;
-      static const uint8_t colonPosition  = 0x02;
+      uint8_t rawPos(uint8_t pos)   { return SevenSegmentLayout::rawPosition(pos, colonPosition); }
+      void    writeDigitRawPos(uint8_t rawpos, uint8_t bitmask);
+      uint8_t copySegments(const uint8_t *segments, uint8_t n, uint8_t startPos, bool inFlash);
 
-      void writeDigitRaw(uint8_t rawpos, uint8_t bitmask);
-      void writeDigitRawPos(uint8_t rawpos, uint8_t bitmask);
+      // Shared with SevenSegmentCounter and SevenSegmentCanvas, for uint32_t and uint64_t values
+      template <typename T> static bool splitNumber(T value, uint8_t base, uint8_t *digit, uint8_t count);
+      template <typename T> static bool formatNumber(uint8_t *segments, uint8_t width, T magnitude, bool negative,
+                                                     uint8_t base, bool padding);
+      static uint8_t nextGlyph(const char *&text, bool inFlash = false);
+      static char    readChar(const char *text, bool inFlash);
 };
 
 
+// Only the inline drawDigit(), clearDigit(), drawDot() and drawSegments() below use the constant geometry,
+// everything else is SevenSegmentBase code that checks and maps at run time
+template <uint8_t Digits, uint8_t ColonPos = SevenSegmentBase::noColon>
+class SevenSegmentT : public SevenSegmentBase
+{
+   static_assert(Digits > 0, "A display needs at least 1 digit");
+   static_assert((ColonPos == noColon) || (ColonPos <= Digits), "The colon must be between or next to the digits");
+   static_assert(Digits + ((ColonPos == noColon) ? 0 : 1) <= bufferSize, "The HT16K33 drives at most 8 digits, colon included");
+
+   public:
+      static const uint8_t displayDigits = Digits;
+
+      SevenSegmentT(uint8_t i2c_addr = defaultI2C_address)
+         : SevenSegmentBase(i2c_addr, Digits, ColonPos)
+      {
+      }
+
+      // The geometry is known here: with a constant position the check and the mapping fold away
+      void drawDigit(uint8_t pos, uint8_t value, bool dot = false)
+      {
+         if (pos < Digits)   drawDigitRaw(rawPosition(pos), value, dot);
+      }
+      void clearDigit(uint8_t pos)
+      {
+         if (pos < Digits)   drawSegmentsRaw(rawPosition(pos), 0x00);
+      }
+      void drawDot(uint8_t pos, bool dot = true)
+      {
+         if (pos < Digits)   drawDotRaw(rawPosition(pos), dot);
+      }
+      void drawSegments(uint8_t pos, uint8_t segments)
+      {
+         if (pos < Digits)   drawSegmentsRaw(rawPosition(pos), segments);
+      }
+
+      // The same with the position checked at compile time: display.drawDigit<0>(5)
+      template <uint8_t Pos> void drawDigit(uint8_t value, bool dot = false)
+      {
+         static_assert(Pos < Digits, "There is no digit at this position");
+         drawDigitRaw(rawPosition(Pos), value, dot);
+      }
+      template <uint8_t Pos> void clearDigit()
+      {
+         static_assert(Pos < Digits, "There is no digit at this position");
+         drawSegmentsRaw(rawPosition(Pos), 0x00);
+      }
+      template <uint8_t Pos> void drawDot(bool dot = true)
+      {
+         static_assert(Pos < Digits, "There is no digit at this position");
+         drawDotRaw(rawPosition(Pos), dot);
+      }
+      template <uint8_t Pos> void drawSegments(uint8_t segments)
+      {
+         static_assert(Pos < Digits, "There is no digit at this position");
+         drawSegmentsRaw(rawPosition(Pos), segments);
+      }
+
+   private:
+      static constexpr uint8_t rawPosition(uint8_t pos)
+      {
+         return SevenSegmentLayout::rawPosition(pos, ColonPos);
+      }
+};
+
+
+// 4 digits with a colon in the middle: Adafruit's 0.56" and 1.2" 7-segment backpacks
+typedef SevenSegmentT<4, 2> SevenSegment;
+
+// 8 digits without colon
+typedef SevenSegmentT<8> SevenSegment8;
+
+
 #endif // SEVENSEGMENT_H
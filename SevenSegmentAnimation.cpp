@@ -0,0 +1,163 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         SevenSegmentAnimation.cpp
+ * Description:  Frame animations on a seven segment display
+ *
+ * This file is part of SevenSegment
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#include "SevenSegmentAnimation.h"
+
+
+//********
+// public
+//********
+
+SevenSegmentAnimation::SevenSegmentAnimation(SevenSegmentBase &d)
+   : display(d)
+{
+}
+//----------------------------------------------------------
+
+void SevenSegmentAnimation::play(const uint8_t *f, uint8_t count, bool r)
+{
+   play(f, count, r, millis());
+}
+//----------------------------------------------------------
+
+void SevenSegmentAnimation::play(const uint8_t *f, uint8_t count, bool r, uint32_t now)
+{
+   stop();
+   if (!f || !count)   return;
+
+   frames     = f;
+   frameCount = count;
+   repeat     = r;
+   frame      = 0;
+   nextFrame  = now;
+
+   // A repeated on/off flash is left to the HT16K33
+   uint8_t rate = blinkRate();
+   if (rate != ht16k33::blink_Off)
+   {
+      drawFrame(frameEmpty(0) ? 1 : 0);
+      display.writeDisplay();
+      savedBlinkRate = display.blinkRate();
+      display.setBlinkRate(rate);
+      hardwareBlink = true;
+   }
+}
+//----------------------------------------------------------
+
+void SevenSegmentAnimation::stop()
+{
+   if (hardwareBlink)   display.setBlinkRate(savedBlinkRate);
+   hardwareBlink = false;
+   frames        = nullptr;
+}
+//----------------------------------------------------------
+
+bool SevenSegmentAnimation::tick()
+{
+   return tick(millis());
+}
+//----------------------------------------------------------
+
+bool SevenSegmentAnimation::tick(uint32_t now)
+{
+   if (!frames || hardwareBlink || ((int32_t)(now - nextFrame) < 0))   return false;
+
+   drawFrame(frame);
+   display.writeDisplay();
+
+   SevenSegmentTiming::advance(nextFrame, (uint16_t)frameDuration(frame) * timeUnit, now);
+
+   if (++frame >= frameCount)
+   {
+      if (repeat)
+         frame = 0;
+      else
+         frames = nullptr;  // The last frame stays on the display
+   }
+   return true;
+}
+//----------------------------------------------------------
+
+bool SevenSegmentAnimation::playing()
+{
+   return frames != nullptr;
+}
+//----------------------------------------------------------
+
+
+//*********
+// private
+//*********
+
+const uint8_t *SevenSegmentAnimation::framePtr(uint8_t f)
+{
+   return frames + (uint16_t)f * (display.digits() + 1);
+}
+//----------------------------------------------------------
+
+uint8_t SevenSegmentAnimation::frameDuration(uint8_t f)
+{
+   return pgm_read_byte(framePtr(f) + display.digits());
+}
+//----------------------------------------------------------
+
+bool SevenSegmentAnimation::frameEmpty(uint8_t f)
+{
+   const uint8_t *p = framePtr(f);
+
+   for (uint8_t i = 0; i < display.digits(); i++)
+      if (pgm_read_byte(p + i))   return false;
+   return true;
+}
+//----------------------------------------------------------
+
+void SevenSegmentAnimation::drawFrame(uint8_t f)
+{
+   display.blit_P(framePtr(f), display.digits());
+}
+//----------------------------------------------------------
+
+uint8_t SevenSegmentAnimation::blinkRate()
+{
+   // The HT16K33 blink rate matching this animation, blink_Off if it doesn't match any
+   if (!repeat || (frameCount != 2))   return ht16k33::blink_Off;
+   if (frameEmpty(0) == frameEmpty(1))   return ht16k33::blink_Off;
+   if (frameDuration(0) != frameDuration(1))   return ht16k33::blink_Off;
+
+   switch (frameDuration(0))
+   {
+      case 250 / timeUnit:    return ht16k33::blink_2Hz;
+      case 500 / timeUnit:    return ht16k33::blink_1Hz;
+      case 1000 / timeUnit:   return ht16k33::blink_0_5Hz;
+   }
+   return ht16k33::blink_Off;
+}
+//----------------------------------------------------------
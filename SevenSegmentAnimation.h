@@ -0,0 +1,103 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         SevenSegmentAnimation.h
+ * Description:  Frame animations on a seven segment display
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage:
+ *  An animation is a list of frames in flash (PROGMEM). Each frame has 1 byte per digit with the segments,
+ *  from the leftmost digit to the rightmost, followed by 1 byte with the duration of the frame in units of
+ *  10 milliseconds. The colon is not part of the frames.
+ *  For example a spinner on the last digit of a 4 digit display:
+ *     static const uint8_t spinner[] PROGMEM =
+ *     {
+ *        0x00, 0x00, 0x00, 0x01, 10,   // a, 100 ms
+ *        0x00, 0x00, 0x00, 0x02, 10,   // b
+ *        0x00, 0x00, 0x00, 0x04, 10,   // c
+ *        0x00, 0x00, 0x00, 0x08, 10,   // d
+ *        0x00, 0x00, 0x00, 0x10, 10,   // e
+ *        0x00, 0x00, 0x00, 0x20, 10    // f
+ *     };
+ *
+ *  An animation of 2 frames where one of them is empty and both last 250, 500 or 1000 ms is played with
+ *  the blinking of the HT16K33 itself (2 Hz, 1 Hz or 0.5 Hz), without any I2C traffic while it plays.
+ *  The hardware blinking includes the colon.
+ *
+ *  Initialise with SevenSegmentAnimation animation = SevenSegmentAnimation(display)
+ *
+ *  play(frames, frameCount, repeat = true) or play(frames, frameCount, repeat, now)
+ *     start playing an animation of 'frameCount' frames. 'now' is the time in milliseconds, default millis().
+ *     Use the same time source as tick()
+ *  stop()
+ *     stop playing, the display keeps the current frame. After hardware blinking the blink rate set
+ *     before play() is restored
+ *  tick() or tick(now)
+ *     call this from loop(). When the next frame is due it is drawn and written, otherwise it returns at once.
+ *     Returns true if the display changed. 'now' is the time in milliseconds, default millis()
+ *  playing()
+ *     true while the animation plays
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#ifndef SEVENSEGMENTANIMATION_H
+#define SEVENSEGMENTANIMATION_H
+
+#include <Arduino.h>
+#include <SevenSegment.h>
+
+
+class SevenSegmentAnimation
+{
+   public:
+      SevenSegmentAnimation(SevenSegmentBase &display);
+
+      void play(const uint8_t *frames, uint8_t frameCount, bool repeat = true);
+      void play(const uint8_t *frames, uint8_t frameCount, bool repeat, uint32_t now);
+      void stop();
+      bool tick();
+      bool tick(uint32_t now);
+      bool playing();
+
+   private:
+      static const uint8_t timeUnit = 10;  // ms
+
+      SevenSegmentBase &display;
+      const uint8_t    *frames = nullptr;
+      uint8_t           frameCount;
+      uint8_t           frame;             // Next frame to draw
+      bool              repeat;
+      bool              hardwareBlink = false;
+      uint8_t           savedBlinkRate;    // Blink rate before the hardware blinking, as in setBlinkRate()
+      uint32_t          nextFrame;
+
+      const uint8_t *framePtr(uint8_t f);
+      uint8_t        frameDuration(uint8_t f);
+      bool           frameEmpty(uint8_t f);
+      void           drawFrame(uint8_t f);
+      uint8_t        blinkRate();
+};
+
+#endif // SEVENSEGMENTANIMATION_H
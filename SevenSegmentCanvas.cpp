@@ -0,0 +1,173 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         SevenSegmentCanvas.cpp
+ * Description:  Several seven segment displays combined into one wide display
+ *
+ * This file is part of SevenSegment
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#include "SevenSegmentCanvas.h"
+
+
+//********
+// public
+//********
+
+bool SevenSegmentCanvas::add(SevenSegmentBase &d)
+{
+   if ((displayCount >= maxDisplays) || (digitCount + d.digits() > maxDigits))   return false;
+
+   display[displayCount++] = &d;
+   digitCount += d.digits();
+   return true;
+}
+//----------------------------------------------------------
+
+uint8_t SevenSegmentCanvas::digits()
+{
+   return digitCount;
+}
+//----------------------------------------------------------
+
+void SevenSegmentCanvas::writeDisplay()
+{
+   for (uint8_t i = 0; i < displayCount; i++)   display[i]->writeDisplay();
+}
+//----------------------------------------------------------
+
+void SevenSegmentCanvas::clearDigits()
+{
+   for (uint8_t i = 0; i < displayCount; i++)   display[i]->clearDigits();
+}
+//----------------------------------------------------------
+
+void SevenSegmentCanvas::drawDigit(uint8_t pos, uint8_t value, bool dot)
+{
+   SevenSegmentBase *d = displayAt(pos);
+   if (d)   d->drawDigit(pos, value, dot);
+}
+//----------------------------------------------------------
+
+void SevenSegmentCanvas::clearDigit(uint8_t pos)
+{
+   SevenSegmentBase *d = displayAt(pos);
+   if (d)   d->clearDigit(pos);
+}
+//----------------------------------------------------------
+
+void SevenSegmentCanvas::drawDot(uint8_t pos, bool dot)
+{
+   SevenSegmentBase *d = displayAt(pos);
+   if (d)   d->drawDot(pos, dot);
+}
+//----------------------------------------------------------
+
+void SevenSegmentCanvas::drawSegments(uint8_t pos, uint8_t segments)
+{
+   SevenSegmentBase *d = displayAt(pos);
+   if (d)   d->drawSegments(pos, segments);
+}
+//----------------------------------------------------------
+
+void SevenSegmentCanvas::drawHyphen(uint8_t pos)
+{
+   SevenSegmentBase *d = displayAt(pos);
+   if (d)   d->drawHyphen(pos);
+}
+//----------------------------------------------------------
+
+void SevenSegmentCanvas::drawOver(uint8_t pos)
+{
+   SevenSegmentBase *d = displayAt(pos);
+   if (d)   d->drawOver(pos);
+}
+//----------------------------------------------------------
+
+void SevenSegmentCanvas::drawUnder(uint8_t pos)
+{
+   SevenSegmentBase *d = displayAt(pos);
+   if (d)   d->drawUnder(pos);
+}
+//----------------------------------------------------------
+
+void SevenSegmentCanvas::drawColon(uint8_t d, bool status)
+{
+   if (d < displayCount)   display[d]->drawColon(status);
+}
+//----------------------------------------------------------
+
+bool SevenSegmentCanvas::printNumber(int64_t number, uint8_t base, bool padding)
+{
+   return printNumber(0, digitCount, number, base, padding);
+}
+//----------------------------------------------------------
+
+bool SevenSegmentCanvas::printNumber(uint8_t pos, uint8_t width, int64_t number, uint8_t base, bool padding)
+{
+   uint8_t  segments[maxDigits];
+   bool     negative = (number < 0);
+   uint64_t value    = negative ? 0 - (uint64_t)number : number;
+
+   if (pos >= digitCount)   return false;
+   if (width > digitCount - pos)   width = digitCount - pos;
+   if (width == 0)   return false;
+
+   // Formatted like SevenSegment::printNumber(), then drawn on the displays
+   bool fits = SevenSegmentBase::formatNumber(segments, width, value, negative, base, padding);
+   for (uint8_t i = 0; i < width; i++)   drawSegments(pos + i, segments[i]);
+   return fits;
+}
+//----------------------------------------------------------
+
+bool SevenSegmentCanvas::printTime(uint8_t pos, uint8_t first, uint8_t last)
+{
+   for (uint8_t i = 0; i < 4; i++)   clearDigit(pos + i);
+   if ((first > 99) || (last > 99))  return false;  // 99:99 is the highest allowed
+
+   drawDigit(pos,     first / 10);
+   drawDigit(pos + 1, first % 10);
+   drawDigit(pos + 2, last / 10);
+   drawDigit(pos + 3, last % 10);
+   return true;
+}
+//----------------------------------------------------------
+
+
+//*********
+// private
+//*********
+
+SevenSegmentBase *SevenSegmentCanvas::displayAt(uint8_t &pos)
+{
+   // Find the display showing canvas position 'pos' and convert pos to a position on that display
+   for (uint8_t i = 0; i < displayCount; i++)
+   {
+      if (pos < display[i]->digits())   return display[i];
+      pos -= display[i]->digits();
+   }
+   return nullptr;
+}
+//----------------------------------------------------------
@@ -0,0 +1,107 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         SevenSegmentCanvas.h
+ * Description:  Several seven segment displays combined into one wide display
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage:
+ *  General:
+ *   A canvas puts up to 8 displays side by side, the first one added is the leftmost. The positions
+ *   range from 0 (leftmost digit of the first display) to digits() - 1 (rightmost digit of the last
+ *   display), the colon of each display is skipped. At most 32 digits are supported.
+ *   The canvas draws directly in the buffers of the displays, writeDisplay() then sends only the changed
+ *   digits of each display.
+ *
+ *  Initialise with SevenSegmentCanvas canvas = SevenSegmentCanvas(), then add the displays:
+ *   add(display)
+ *      add a display at the right side, returns false if it doesn't fit
+ *   digits()
+ *      the total number of digits
+ *
+ *  Update the display
+ * ~~~~~~~~~~~~~~~~~~~~
+ *   writeDisplay()
+ *      write the changes of all displays
+ *
+ *  Digit handling       Same as for SevenSegment, with positions on the canvas
+ * ~~~~~~~~~~~~~~~~
+ *   clearDigits(), drawDigit(pos, value, dot = false), clearDigit(pos), drawDot(pos, dot = true),
+ *   drawSegments(pos, segments), drawHyphen(pos), drawOver(pos), drawUnder(pos)
+ *   drawColon(display, status = true)
+ *      draw or remove the colon of the display with index 'display' (0 is the first display added)
+ *
+ *  Print methods
+ * ~~~~~~~~~~~~~~~
+ *   printNumber(number, base = 10, padding = false)
+ *      print a 64 bit number over the whole canvas, with the same rules as SevenSegment::printNumber()
+ *   printNumber(pos, width, number, base = 10, padding = false)
+ *      print a number in the field of 'width' digits starting at position 'pos'
+ *   printTime(pos, first, last)
+ *      print a time in the 4 digits starting at position 'pos', like SevenSegment::printTime()
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#ifndef SEVENSEGMENTCANVAS_H
+#define SEVENSEGMENTCANVAS_H
+
+#include <SevenSegment.h>
+
+
+class SevenSegmentCanvas
+{
+   public:
+      static const uint8_t maxDisplays = 0x08;
+      static const uint8_t maxDigits   = 0x20;
+
+      bool    add(SevenSegmentBase &display);
+      uint8_t digits();
+      void    writeDisplay();
+
+      // Digit handling
+      void clearDigits();
+      void drawDigit(uint8_t pos, uint8_t value, bool dot = false);
+      void clearDigit(uint8_t pos);
+      void drawDot(uint8_t pos, bool dot = true);
+      void drawSegments(uint8_t pos, uint8_t segments);
+      void drawHyphen(uint8_t pos);
+      void drawOver(uint8_t pos);
+      void drawUnder(uint8_t pos);
+      void drawColon(uint8_t display, bool status = true);
+
+      // Print functions
+      bool printNumber(int64_t number, uint8_t base = 10, bool padding = false);
+      bool printNumber(uint8_t pos, uint8_t width, int64_t number, uint8_t base = 10, bool padding = false);
+      bool printTime(uint8_t pos, uint8_t first, uint8_t last);
+
+   private:
+      SevenSegmentBase *display[maxDisplays];
+      uint8_t           displayCount = 0;
+      uint8_t           digitCount   = 0;
+
+      SevenSegmentBase *displayAt(uint8_t &pos);
+};
+
+#endif // SEVENSEGMENTCANVAS_H
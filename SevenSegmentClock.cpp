@@ -0,0 +1,192 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         SevenSegmentClock.cpp
+ * Description:  Clock on a seven segment display
+ *
+ * This file is part of SevenSegment
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#include "SevenSegmentClock.h"
+
+
+//********
+// public
+//********
+
+SevenSegmentClock::SevenSegmentClock(SevenSegmentBase &d)
+   : display(d)
+{
+}
+//----------------------------------------------------------
+
+bool SevenSegmentClock::setTime(uint8_t h, uint8_t m, uint8_t s)
+{
+   return setTime(h, m, s, millis());
+}
+//----------------------------------------------------------
+
+bool SevenSegmentClock::setTime(uint8_t h, uint8_t m, uint8_t s, uint32_t now)
+{
+   if ((h > 23) || (m > 59) || (s > 59))   return false;
+
+   hour       = h;
+   minute     = m;
+   sec        = s;
+   nextSecond = now + second;
+   nextEvent  = now;
+   shownFirst = shownLast = nothing;  // Draw everything
+   running    = true;
+   return true;
+}
+//----------------------------------------------------------
+
+void SevenSegmentClock::setFormat(uint8_t f)
+{
+   format     = f;
+   shownFirst = shownLast = nothing;
+   nextEvent  = nextSecond - second;  // Start of this second, so due at once
+}
+//----------------------------------------------------------
+
+void SevenSegmentClock::setColonBlink(bool blink)
+{
+   colonBlink = blink;
+   nextEvent  = nextSecond - second;
+}
+//----------------------------------------------------------
+
+bool SevenSegmentClock::update()
+{
+   return update(millis());
+}
+//----------------------------------------------------------
+
+bool SevenSegmentClock::update(uint32_t now)
+{
+   if (!running || ((int32_t)(now - nextEvent) < 0))   return false;
+
+   // Count every second that passed, however late this is called
+   while ((int32_t)(now - nextSecond) >= 0)
+   {
+      nextSecond += second;
+      addSecond();
+   }
+
+   // When blinking the colon is on in the first half of the second
+   uint32_t colonOff = nextSecond - second + colonTime;
+   bool     colon    = !colonBlink || ((int32_t)(now - colonOff) < 0);
+
+   nextEvent = (colonBlink && colon) ? colonOff : nextSecond;
+
+   bool colonChanged = (colon != shownColon);
+   shownColon = colon;
+   display.drawColon(colon);
+
+   if (drawTime())
+      display.writeDisplay();
+   else if (colonChanged)
+      display.writeColon();
+   else
+      return false;
+   return true;
+}
+//----------------------------------------------------------
+
+uint8_t SevenSegmentClock::hours()
+{
+   return hour;
+}
+//----------------------------------------------------------
+
+uint8_t SevenSegmentClock::minutes()
+{
+   return minute;
+}
+//----------------------------------------------------------
+
+uint8_t SevenSegmentClock::seconds()
+{
+   return sec;
+}
+//----------------------------------------------------------
+
+
+//*********
+// private
+//*********
+
+void SevenSegmentClock::addSecond()
+{
+   if (++sec < 60)      return;
+   sec = 0;
+   if (++minute < 60)   return;
+   minute = 0;
+   if (++hour < 24)     return;
+   hour = 0;
+}
+//----------------------------------------------------------
+
+bool SevenSegmentClock::drawTime()
+{
+   uint8_t first, last;
+   bool    pm  = false;
+   bool    all = (shownFirst == nothing);
+
+   switch (format)
+   {
+      case formatMinSec:
+         first = minute;
+         last  = sec;
+         break;
+      case format12h:
+         pm    = (hour >= 12);
+         first = (hour % 12) ? hour % 12 : 12;
+         last  = minute;
+         break;
+      default:
+         first = hour;
+         last  = minute;
+   }
+   if (!all && (first == shownFirst) && (last == shownLast) && (pm == shownPM))   return false;
+
+   // Only draw the digits that changed
+   if (all || (first / 10 != shownFirst / 10))
+   {
+      if ((format == format12h) && (first < 10))
+         display.clearDigit(0);
+      else
+         display.drawDigit(0, first / 10);
+   }
+   if (all || (first % 10 != shownFirst % 10))   display.drawDigit(1, first % 10);
+   if (all || (last / 10 != shownLast / 10))     display.drawDigit(2, last / 10);
+   if (all || (last % 10 != shownLast % 10) || (pm != shownPM))   display.drawDigit(3, last % 10, pm);
+
+   shownFirst = first;
+   shownLast  = last;
+   shownPM    = pm;
+   return true;
+}
+//----------------------------------------------------------
@@ -0,0 +1,105 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         SevenSegmentClock.h
+ * Description:  Clock on a seven segment display
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage:
+ *  The clock counts whole seconds of the time source, so it doesn't drift from it however late update()
+ *  is called. Only the digits that change are drawn, the colon blink is a colon only write.
+ *  The time is shown on the first 4 digits.
+ *
+ *  Initialise with SevenSegmentClock clock = SevenSegmentClock(display)
+ *
+ *  setTime(hours, minutes, seconds = 0) or setTime(hours, minutes, seconds, now)
+ *     set the time and start the clock, returns false if the time is not valid.
+ *     'now' is the time of the time source in milliseconds, default millis()
+ *  setFormat(format)
+ *     SevenSegmentClock::format24h    HH:MM, the default
+ *     SevenSegmentClock::format12h    HH:MM without a leading zero, the dot of the last digit is PM
+ *     SevenSegmentClock::formatMinSec MM:SS
+ *  setColonBlink(blink)
+ *     blink the colon, on in the first half of each second. Without blinking the colon is always on
+ *  update() or update(now)
+ *     call this from loop(). Returns at once when nothing is due, returns true if the display was written.
+ *     'now' is the time of the time source in milliseconds, default millis(). Use the same source as setTime()
+ *  hours(), minutes(), seconds()
+ *     the time of the clock
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#ifndef SEVENSEGMENTCLOCK_H
+#define SEVENSEGMENTCLOCK_H
+
+#include <Arduino.h>
+#include <SevenSegment.h>
+
+
+class SevenSegmentClock
+{
+   public:
+      static const uint8_t format24h    = 0x00;
+      static const uint8_t format12h    = 0x01;
+      static const uint8_t formatMinSec = 0x02;
+
+      SevenSegmentClock(SevenSegmentBase &display);
+
+      bool    setTime(uint8_t hours, uint8_t minutes, uint8_t seconds = 0);
+      bool    setTime(uint8_t hours, uint8_t minutes, uint8_t seconds, uint32_t now);
+      void    setFormat(uint8_t format);
+      void    setColonBlink(bool blink);
+      bool    update();
+      bool    update(uint32_t now);
+      uint8_t hours();
+      uint8_t minutes();
+      uint8_t seconds();
+
+   private:
+      static const uint16_t second    = 1000;  // ms
+      static const uint16_t colonTime = 500;   // ms the colon is on when blinking
+      static const uint8_t  nothing   = 0xFF;  // Nothing shown yet
+
+      SevenSegmentBase &display;
+      bool              running    = false;
+      uint8_t           format     = format24h;
+      bool              colonBlink = true;
+      uint8_t           hour;
+      uint8_t           minute;
+      uint8_t           sec;
+      uint32_t          nextSecond;          // Start of the next second
+      uint32_t          nextEvent;           // Next second or colon change
+
+      // What is on the display
+      uint8_t           shownFirst = nothing;
+      uint8_t           shownLast  = nothing;
+      bool              shownPM    = false;
+      bool              shownColon = false;
+
+      void addSecond();
+      bool drawTime();
+};
+
+#endif // SEVENSEGMENTCLOCK_H
@@ -0,0 +1,192 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         SevenSegmentCounter.cpp
+ * Description:  Incremental counter and MM:SS timer on a seven segment display
+ *
+ * This file is part of SevenSegment
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#include "SevenSegmentCounter.h"
+
+
+//********
+// public
+//********
+
+SevenSegmentCounter::SevenSegmentCounter(SevenSegmentBase &d)
+   : display(d)
+{
+}
+//----------------------------------------------------------
+
+bool SevenSegmentCounter::setCounter(uint32_t value, bool pad)
+{
+   mode = counterOff;
+   if (!SevenSegmentBase::splitNumber(value, DEC, digit, display.digits()))
+   {
+      display.clearDigits();
+      display.drawLineUpper();
+      return false;
+   }
+
+   mode    = counterDecimal;
+   padding = pad;
+   draw(0);
+   return true;
+}
+//----------------------------------------------------------
+
+bool SevenSegmentCounter::setTimer(uint8_t minutes, uint8_t seconds)
+{
+   mode = counterOff;
+   if ((display.digits() < timerDigits) || (minutes > 99) || (seconds > 59))   return false;
+
+   SevenSegmentBase::splitNumber<uint32_t>(minutes, DEC, digit, 2);
+   SevenSegmentBase::splitNumber<uint32_t>(seconds, DEC, digit + 2, 2);
+   mode    = counterTimer;
+   padding = true;
+   draw(0);
+   return true;
+}
+//----------------------------------------------------------
+
+bool SevenSegmentCounter::increment()
+{
+   if (!running())   return false;
+
+   // Find the digit that doesn't carry
+   int8_t pos = length() - 1;
+   while ((pos >= 0) && (digit[pos] + 1 >= limit(pos)))   pos--;
+   if (pos >= 0)
+      digit[pos]++;
+   else if (mode != counterTimer)
+      return false;   // Counter stops at its maximum, the timer wraps to 00:00
+
+   for (uint8_t i = pos + 1; i < length(); i++)   digit[i] = 0;
+   draw((pos >= 0) ? pos : 0);
+   return true;
+}
+//----------------------------------------------------------
+
+bool SevenSegmentCounter::decrement()
+{
+   if (!running())   return false;
+
+   // Find the digit that doesn't borrow
+   int8_t pos = length() - 1;
+   while ((pos >= 0) && (digit[pos] == 0))   pos--;
+   if (pos < 0)   return false;   // Already at 0
+
+   digit[pos]--;
+   for (uint8_t i = pos + 1; i < length(); i++)   digit[i] = limit(i) - 1;
+   draw(pos);
+   return true;
+}
+//----------------------------------------------------------
+
+bool SevenSegmentCounter::addSeconds(uint16_t n)
+{
+   if ((mode != counterTimer) || !running())   return false;
+
+   // One addition with carry on MM:SS, the timer wraps from 99:59 to 00:00
+   uint16_t seconds = (digit[2] * 10 + digit[3]) + (n % timerWrap);
+   uint16_t minutes = (digit[0] * 10 + digit[1]) + seconds / 60;
+   uint8_t  next[timerDigits];
+
+   SevenSegmentBase::splitNumber<uint32_t>(minutes % 100, DEC, next, 2);
+   SevenSegmentBase::splitNumber<uint32_t>(seconds % 60, DEC, next + 2, 2);
+
+   // Only the digits from the first change on are drawn
+   uint8_t from = 0;
+   while ((from < timerDigits) && (next[from] == digit[from]))   from++;
+   for (uint8_t i = from; i < timerDigits; i++)   digit[i] = next[i];
+   if (from < timerDigits)   draw(from);
+   return true;
+}
+//----------------------------------------------------------
+
+
+//*********
+// Private
+//*********
+
+uint8_t SevenSegmentCounter::length()
+{
+   return (mode == counterTimer) ? timerDigits : display.digits();
+}
+//----------------------------------------------------------
+
+uint8_t SevenSegmentCounter::limit(uint8_t pos)
+{
+   // Tens of seconds go up to 5, all other digits to 9
+   return ((mode == counterTimer) && (pos == 2)) ? 6 : 10;
+}
+//----------------------------------------------------------
+
+uint8_t SevenSegmentCounter::leadingBlanks()
+{
+   // Leading zeros stay blank unless padding, the last digit is always drawn
+   uint8_t lead = 0;
+   if (!padding)
+      while ((lead < length() - 1) && (digit[lead] == 0))   lead++;
+   return lead;
+}
+//----------------------------------------------------------
+
+bool SevenSegmentCounter::running()
+{
+   // The counter stops as soon as its digits show anything else
+   uint8_t segments[ht16k33::bufferSize];
+   uint8_t lead = leadingBlanks();
+
+   if (mode == counterOff)   return false;
+   display.readRaw(segments, length());
+   for (uint8_t i = 0; i < length(); i++)
+   {
+      if (segments[i] != ((i < lead) ? 0x00 : SevenSegmentBase::glyph('0' + digit[i])))
+      {
+         mode = counterOff;
+         return false;
+      }
+   }
+   return true;
+}
+//----------------------------------------------------------
+
+void SevenSegmentCounter::draw(uint8_t from)
+{
+   // Redraw the digits from position 'from' on
+   uint8_t lead = leadingBlanks();
+
+   for (uint8_t i = from; i < length(); i++)
+   {
+      if (i < lead)
+         display.clearDigit(i);
+      else
+         display.drawDigit(i, digit[i]);
+   }
+}
+//----------------------------------------------------------
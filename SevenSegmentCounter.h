@@ -0,0 +1,88 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         SevenSegmentCounter.h
+ * Description:  Incremental counter and MM:SS timer on a seven segment display
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage:
+ *  Only the digits that change are drawn. The counter stops (the methods return false) when anything else
+ *  was drawn on its digits, for example by a print method, clearDigits() or clearDisplay()
+ *
+ *  Initialise with SevenSegmentCounter counter = SevenSegmentCounter(display)
+ *
+ *  setCounter(value, padding = false)
+ *     start a decimal counter at value, displayed like printNumber(value, DEC, padding). Returns false on overflow
+ *  setTimer(minutes, seconds)
+ *     start a MM:SS timer on the first 4 digits, displayed like printTime(minutes, seconds).
+ *     Returns false if the time is not valid
+ *  increment()
+ *     add 1 to the counter or 1 second to the timer. A counter stops at its maximum and returns false,
+ *     the timer wraps from 99:59 to 00:00
+ *  decrement()
+ *     subtract 1 from the counter or 1 second from the timer. Returns false at 0 or 00:00
+ *  addSeconds(n)
+ *     add n seconds to the timer, wrapping like increment(). The digits are drawn once
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#ifndef SEVENSEGMENTCOUNTER_H
+#define SEVENSEGMENTCOUNTER_H
+
+#include <Arduino.h>
+#include <SevenSegment.h>
+
+
+class SevenSegmentCounter
+{
+   public:
+      SevenSegmentCounter(SevenSegmentBase &display);
+
+      bool setCounter(uint32_t value, bool padding = false);
+      bool setTimer(uint8_t minutes, uint8_t seconds);
+      bool increment();
+      bool decrement();
+      bool addSeconds(uint16_t n);
+
+   private:
+      static const uint8_t  counterOff     = 0x00;
+      static const uint8_t  counterDecimal = 0x01;
+      static const uint8_t  counterTimer   = 0x02;
+      static const uint8_t  timerDigits    = 0x04;  // MM:SS
+      static const uint16_t timerWrap      = 6000;  // Seconds from 00:00 to 99:59, plus 1
+
+      SevenSegmentBase &display;
+      uint8_t           mode = counterOff;
+      bool              padding;
+      uint8_t           digit[ht16k33::bufferSize];
+
+      uint8_t length();
+      uint8_t limit(uint8_t pos);
+      uint8_t leadingBlanks();
+      bool    running();
+      void    draw(uint8_t from);
+};
+
+#endif // SEVENSEGMENTCOUNTER_H
@@ -0,0 +1,80 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         SevenSegmentDimmer.cpp
+ * Description:  Brightness per digit for a seven segment display
+ *
+ * This file is part of SevenSegment
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#include "SevenSegmentDimmer.h"
+
+
+//********
+// public
+//********
+
+SevenSegmentDimmer::SevenSegmentDimmer(SevenSegmentBase &d)
+   : display(d)
+{
+   for (uint8_t i = 0; i < ht16k33::bufferSize; i++)   level[i] = levels;
+}
+//----------------------------------------------------------
+
+void SevenSegmentDimmer::setLevel(uint8_t pos, uint8_t l)
+{
+   if (pos >= display.digits())   return;
+   level[pos] = (l > levels) ? levels : l;
+}
+//----------------------------------------------------------
+
+void SevenSegmentDimmer::setPeriod(uint16_t period)
+{
+   subframeTime = period / levels;
+}
+//----------------------------------------------------------
+
+bool SevenSegmentDimmer::tick()
+{
+   return tick(micros());
+}
+//----------------------------------------------------------
+
+bool SevenSegmentDimmer::tick(uint32_t now)
+{
+   if ((int32_t)(now - nextSubframe) < 0)   return false;
+
+   SevenSegmentTiming::advance(nextSubframe, subframeTime, now);  // us
+   if (++subframe >= levels)   subframe = 0;
+
+   // A digit is lit in the first 'level' sub-frames
+   uint8_t blank = 0x00;
+   for (uint8_t i = 0; i < display.digits(); i++)
+      if (level[i] <= subframe)   blank |= (1 << i);
+
+   display.blankDigits(blank);
+   return true;
+}
+//----------------------------------------------------------
@@ -0,0 +1,79 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         SevenSegmentDimmer.h
+ * Description:  Brightness per digit for a seven segment display
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage:
+ *  The HT16K33 only dims the whole display. The dimmer divides a period in SevenSegmentDimmer::levels
+ *  sub-frames and blanks a digit with brightness level L in all sub-frames from L on, so it is lit for
+ *  L / levels of the time. Level 0 is off, SevenSegmentDimmer::levels is full brightness.
+ *  Only digits that turn on or off are written, so per period there are at most 'levels' small writes,
+ *  and none at all while every digit is at level 0 or full brightness.
+ *  The default period of 16 ms (62.5 Hz) is flicker free. With 4 levels it costs at most 250 writes of a
+ *  few bytes per second: about 13% of a 100 kHz I2C bus, or 3% at 400 kHz.
+ *
+ *  Initialise with SevenSegmentDimmer dimmer = SevenSegmentDimmer(display)
+ *
+ *  setLevel(pos, level)
+ *     set the brightness level of the digit at position 'pos', from 0 to SevenSegmentDimmer::levels
+ *  setPeriod(period)
+ *     the period in microseconds, default SevenSegmentDimmer::defaultPeriod
+ *  tick() or tick(now)
+ *     call this often from loop(), or from a timer interrupt if the display is in asynchronous mode (the writes
+ *     are then sent by service()). Returns true at the start of a sub-frame. 'now' is in microseconds, default micros()
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#ifndef SEVENSEGMENTDIMMER_H
+#define SEVENSEGMENTDIMMER_H
+
+#include <Arduino.h>
+#include <SevenSegment.h>
+
+
+class SevenSegmentDimmer
+{
+   public:
+      static const uint8_t  levels        = 4;
+      static const uint16_t defaultPeriod = 16000;  // us
+
+      SevenSegmentDimmer(SevenSegmentBase &display);
+
+      void setLevel(uint8_t pos, uint8_t level);
+      void setPeriod(uint16_t period);
+      bool tick();
+      bool tick(uint32_t now);
+
+   private:
+      SevenSegmentBase &display;
+      uint8_t           level[ht16k33::bufferSize];
+      uint8_t           subframe     = 0;
+      uint16_t          subframeTime = defaultPeriod / levels;
+      uint32_t          nextSubframe = 0;
+};
+
+#endif // SEVENSEGMENTDIMMER_H
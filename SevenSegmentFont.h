@@ -0,0 +1,86 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         SevenSegmentFont.h
+ * Description:  Segment patterns of the Seven Segment driver
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage
+ *  The font data as initialiser lists, so the run time tables in flash and the compile time
+ *  tables of SevenSegmentFrame.h are built from the same data.
+ *  Bit 0 to 6 are segment a to g, bit 7 is the dot.
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#ifndef SEVENSEGMENTFONT_H
+#define SEVENSEGMENTFONT_H
+
+// Numbers from 0 to 9 or 0x0 to 0xF
+#define SEVENSEGMENT_NUMBER_FONT \
+   0x3F, /* 0 */ \
+   0x06, /* 1 */ \
+   0x5B, /* 2 */ \
+   0x4F, /* 3 */ \
+   0x66, /* 4 */ \
+   0x6D, /* 5 */ \
+   0x7D, /* 6 */ \
+   0x07, /* 7 */ \
+   0x7F, /* 8 */ \
+   0x6F, /* 9 */ \
+   0x77, /* a */ \
+   0x7C, /* b */ \
+   0x39, /* C */ \
+   0x5E, /* d */ \
+   0x79, /* E */ \
+   0x71  /* F */
+
+// Printable ASCII characters, 0x20 to 0x7F. Characters that can't be displayed are left empty
+#define SEVENSEGMENT_ASCII_FONT \
+   /*  space    !     "     #     $     %     &     '  */ \
+       0x00, 0x86, 0x22, 0x7E, 0x6D, 0xD2, 0x46, 0x20, \
+   /*    (      )     *     +     ,     -     .     /  */ \
+       0x39, 0x0F, 0x63, 0x70, 0x10, 0x40, 0x80, 0x52, \
+   /*    0      1     2     3     4     5     6     7  */ \
+       0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, \
+   /*    8      9     :     ;     <     =     >     ?  */ \
+       0x7F, 0x6F, 0x09, 0x0D, 0x61, 0x48, 0x43, 0xD3, \
+   /*    @      A     B     C     D     E     F     G  */ \
+       0x5F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71, 0x3D, \
+   /*    H      I     J     K     L     M     N     O  */ \
+       0x76, 0x30, 0x1E, 0x75, 0x38, 0x15, 0x37, 0x3F, \
+   /*    P      Q     R     S     T     U     V     W  */ \
+       0x73, 0x6B, 0x33, 0x6D, 0x78, 0x3E, 0x3E, 0x2A, \
+   /*    X      Y     Z     [     \     ]     ^     _  */ \
+       0x76, 0x6E, 0x5B, 0x39, 0x64, 0x0F, 0x23, 0x08, \
+   /*    `      a     b     c     d     e     f     g  */ \
+       0x02, 0x5F, 0x7C, 0x58, 0x5E, 0x7B, 0x71, 0x6F, \
+   /*    h      i     j     k     l     m     n     o  */ \
+       0x74, 0x10, 0x0C, 0x75, 0x30, 0x14, 0x54, 0x5C, \
+   /*    p      q     r     s     t     u     v     w  */ \
+       0x73, 0x67, 0x50, 0x6D, 0x78, 0x1C, 0x1C, 0x14, \
+   /*    x      y     z     {     |     }     ~    del */ \
+       0x76, 0x6E, 0x5B, 0x46, 0x30, 0x70, 0x01, 0x00
+
+#endif // SEVENSEGMENTFONT_H
@@ -0,0 +1,143 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         SevenSegmentFrame.h
+ * Description:  Seven segment frames built at compile time
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage:
+ *  A SevenSegmentFrame<digits> holds the segments of 'digits' digits. text() and number() build one at
+ *  compile time, the result looks exactly like printString() and printNumber() would draw it, but costs
+ *  no formatting at run time. Store the frames in flash:
+ *
+ *     static const SevenSegmentFrame<4> errorFrame PROGMEM = SevenSegmentFrame<4>::text("Err");
+ *     static const SevenSegmentFrame<4> limitFrame PROGMEM = SevenSegmentFrame<4>::number(-250);
+ *
+ *  SevenSegmentFrame<digits>::text(text)
+ *     the text from the leftmost digit, a '.' is the dot of the character before it. Text that doesn't fit is cut off
+ *  SevenSegmentFrame<digits>::number(number, base = 10, padding = false)
+ *     the number like printNumber(number, base, padding) on a display with 'digits' digits, overflow included
+ *
+ *  Show a frame with display.show_P(frame) for a frame in flash or display.show(frame) for one in RAM,
+ *  optionally followed by the position of the first digit. Only the digits of the frame are drawn.
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#ifndef SEVENSEGMENTFRAME_H
+#define SEVENSEGMENTFRAME_H
+
+#include <Arduino.h>
+#include <SevenSegment.h>
+#include <SevenSegmentFont.h>
+
+
+// Compile time versions of the SevenSegment formatting, C++11 constexpr: 1 return statement each
+namespace SevenSegmentLayout
+{
+   template <uint8_t... I> struct indices {};
+   template <uint8_t N, uint8_t... I> struct makeIndices : makeIndices<N - 1, N - 1, I...> {};
+   template <uint8_t... I> struct makeIndices<0, I...> { typedef indices<I...> type; };
+
+   template <typename T = void> struct font
+   {
+      static constexpr uint8_t numbers[16] = { SEVENSEGMENT_NUMBER_FONT };
+      static constexpr uint8_t ascii[96]   = { SEVENSEGMENT_ASCII_FONT };
+   };
+   template <typename T> constexpr uint8_t font<T>::numbers[16];
+   template <typename T> constexpr uint8_t font<T>::ascii[96];
+
+   // Text, as SevenSegmentBase::printString()
+   constexpr uint8_t glyph(char c)
+   {
+      return (((uint8_t)c < 0x20) || ((uint8_t)c > 0x7F)) ? 0x00 : font<>::ascii[(uint8_t)c - 0x20];
+   }
+
+   constexpr bool dotFollows(const char *text)
+   {
+      return (text[1] == '.') && !(glyph(text[0]) & 0x80);
+   }
+
+   constexpr const char *charAt(const char *text, uint8_t pos)
+   {
+      return ((pos == 0) || (*text == 0)) ? text : charAt(text + (dotFollows(text) ? 2 : 1), pos - 1);
+   }
+
+   constexpr uint8_t textSegments(const char *text)
+   {
+      return (*text == 0) ? 0x00 : glyph(*text) | (dotFollows(text) ? 0x80 : 0x00);
+   }
+
+   // Numbers, as SevenSegmentBase::printNumber()
+   constexpr uint64_t power(uint8_t base, uint8_t exponent)
+   {
+      return exponent ? base * power(base, exponent - 1) : 1;
+   }
+
+   constexpr uint32_t magnitude(int32_t number)
+   {
+      return (number < 0) ? 0 - (uint32_t)number : number;
+   }
+
+   constexpr uint8_t numberSegments(int32_t number, uint8_t base, bool padding, uint8_t digits, uint8_t pos)
+   {
+      return ((base < 2) || (base > 16)) ? 0x00
+           : (magnitude(number) >= power(base, digits)) ? ((number < 0) ? 0x08 : 0x01)                     // Overflow
+           : ((number < 0) && (pos == 0) && (magnitude(number) < power(base, digits - 1))) ? 0x40          // Sign
+           : (!padding && (pos + 1 < digits) && (magnitude(number) < power(base, digits - 1 - pos))) ? 0x00  // Leading zero
+           : font<>::numbers[(magnitude(number) / power(base, digits - 1 - pos)) % base] |
+             (((number < 0) && (pos + 1 == digits) && (magnitude(number) >= power(base, digits - 1))) ? 0x80 : 0x00);
+   }
+}
+
+
+template <uint8_t Digits>
+struct SevenSegmentFrame
+{
+   uint8_t segments[Digits];
+
+   static constexpr SevenSegmentFrame text(const char *text)
+   {
+      return textFrame(text, typename SevenSegmentLayout::makeIndices<Digits>::type());
+   }
+
+   static constexpr SevenSegmentFrame number(int32_t number, uint8_t base = 10, bool padding = false)
+   {
+      return numberFrame(number, base, padding, typename SevenSegmentLayout::makeIndices<Digits>::type());
+   }
+
+   template <uint8_t... I>
+   static constexpr SevenSegmentFrame textFrame(const char *text, SevenSegmentLayout::indices<I...>)
+   {
+      return { { SevenSegmentLayout::textSegments(SevenSegmentLayout::charAt(text, I))... } };
+   }
+
+   template <uint8_t... I>
+   static constexpr SevenSegmentFrame numberFrame(int32_t number, uint8_t base, bool padding, SevenSegmentLayout::indices<I...>)
+   {
+      return { { SevenSegmentLayout::numberSegments(number, base, padding, Digits, I)... } };
+   }
+};
+
+#endif // SEVENSEGMENTFRAME_H
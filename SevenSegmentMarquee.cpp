@@ -0,0 +1,141 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         SevenSegmentMarquee.cpp
+ * Description:  Scrolling text on a seven segment display
+ *
+ * This file is part of SevenSegment
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#include "SevenSegmentMarquee.h"
+
+
+//********
+// public
+//********
+
+SevenSegmentMarquee::SevenSegmentMarquee(SevenSegmentBase &d)
+   : display(d)
+{
+}
+//----------------------------------------------------------
+
+void SevenSegmentMarquee::start(const char *t, uint16_t i, bool r)
+{
+   begin(t, false, i, r, millis());
+}
+//----------------------------------------------------------
+
+void SevenSegmentMarquee::start(const char *t, uint16_t i, bool r, uint32_t now)
+{
+   begin(t, false, i, r, now);
+}
+//----------------------------------------------------------
+
+void SevenSegmentMarquee::start(const __FlashStringHelper *t, uint16_t i, bool r)
+{
+   begin((const char *)t, true, i, r, millis());
+}
+//----------------------------------------------------------
+
+void SevenSegmentMarquee::start(const __FlashStringHelper *t, uint16_t i, bool r, uint32_t now)
+{
+   begin((const char *)t, true, i, r, now);
+}
+//----------------------------------------------------------
+
+void SevenSegmentMarquee::stop()
+{
+   text = nullptr;
+}
+//----------------------------------------------------------
+
+bool SevenSegmentMarquee::tick()
+{
+   return tick(millis());
+}
+//----------------------------------------------------------
+
+bool SevenSegmentMarquee::tick(uint32_t now)
+{
+   if (!text || ((int32_t)(now - nextStep) < 0))   return false;
+
+   SevenSegmentTiming::advance(nextStep, interval, now);
+
+   if (readChar(next))
+      display.scrollLeft(SevenSegmentBase::nextGlyph(next, inFlash));
+   else if (trailing)
+   {
+      display.scrollLeft(SevenSegmentBase::glyph(' '));
+      trailing--;
+   }
+
+   // Text has scrolled out
+   if (!readChar(next) && !trailing)
+   {
+      if (repeat)
+      {
+         next     = text;
+         trailing = display.digits();
+      }
+      else
+         text = nullptr;
+   }
+
+   display.writeDisplay();
+   return true;
+}
+//----------------------------------------------------------
+
+bool SevenSegmentMarquee::running()
+{
+   return text != nullptr;
+}
+//----------------------------------------------------------
+
+
+//*********
+// private
+//*********
+
+void SevenSegmentMarquee::begin(const char *t, bool f, uint16_t i, bool r, uint32_t now)
+{
+   text     = t;
+   next     = t;
+   inFlash  = f;
+   interval = i;
+   repeat   = r;
+   trailing = display.digits();
+   nextStep = now;
+
+   display.clearDigits();
+}
+//----------------------------------------------------------
+
+char SevenSegmentMarquee::readChar(const char *p)
+{
+   return SevenSegmentBase::readChar(p, inFlash);
+}
+//----------------------------------------------------------
@@ -0,0 +1,88 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         SevenSegmentMarquee.h
+ * Description:  Scrolling text on a seven segment display
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage:
+ *  The text enters at the right side of the display and scrolls to the left, one character per step.
+ *  Each step moves the digits already on the display and only draws the new character.
+ *  The text is not copied, it must stay available while scrolling.
+ *
+ *  Initialise with SevenSegmentMarquee marquee = SevenSegmentMarquee(display)
+ *
+ *  start(text, interval = 300, repeat = false)
+ *  start(F("text"), interval = 300, repeat = false)
+ *  start(text, interval, repeat, now)
+ *     start scrolling a text in RAM or in flash, one step every 'interval' milliseconds.
+ *     With repeat the text starts again when it has scrolled out of the display.
+ *     The first step is due at 'now', default millis(). Use the same time source as tick(now)
+ *  stop()
+ *     stop scrolling, the display keeps its contents
+ *  tick() or tick(now)
+ *     call this from loop(). When a step is due the display is scrolled and written, otherwise it returns at once.
+ *     Returns true if the display changed. 'now' is the time in milliseconds, default millis()
+ *  running()
+ *     true while the text is scrolling
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#ifndef SEVENSEGMENTMARQUEE_H
+#define SEVENSEGMENTMARQUEE_H
+
+#include <Arduino.h>
+#include <SevenSegment.h>
+
+
+class SevenSegmentMarquee
+{
+   public:
+      SevenSegmentMarquee(SevenSegmentBase &display);
+
+      void start(const char *text, uint16_t interval = 300, bool repeat = false);
+      void start(const char *text, uint16_t interval, bool repeat, uint32_t now);
+      void start(const __FlashStringHelper *text, uint16_t interval = 300, bool repeat = false);
+      void start(const __FlashStringHelper *text, uint16_t interval, bool repeat, uint32_t now);
+      void stop();
+      bool tick();
+      bool tick(uint32_t now);
+      bool running();
+
+   private:
+      SevenSegmentBase &display;
+      const char       *text     = nullptr;
+      const char       *next;            // Next character to scroll in
+      bool              inFlash;
+      bool              repeat;
+      uint8_t           trailing;        // Blanks still to scroll in after the text
+      uint16_t          interval;
+      uint32_t          nextStep;
+
+      void    begin(const char *text, bool inFlash, uint16_t interval, bool repeat, uint32_t now);
+      char    readChar(const char *p);
+};
+
+#endif // SEVENSEGMENTMARQUEE_H
@@ -0,0 +1,166 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         SevenSegmentPager.cpp
+ * Description:  Several readings on one seven segment display, one page at a time
+ *
+ * This file is part of SevenSegment
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#include "SevenSegmentPager.h"
+
+
+//********
+// public
+//********
+
+SevenSegmentPager::SevenSegmentPager(SevenSegmentBase &d)
+   : display(d)
+{
+}
+//----------------------------------------------------------
+
+bool SevenSegmentPager::addNumber(Source source, uint8_t base, bool padding, char label)
+{
+   return add(source, formatNumber, base, padding, label);
+}
+//----------------------------------------------------------
+
+bool SevenSegmentPager::addFixed(Source source, uint8_t decimals, char label)
+{
+   return add(source, formatFixed, decimals, false, label);
+}
+//----------------------------------------------------------
+
+bool SevenSegmentPager::addTime(Source source)
+{
+   return add(source, formatTime, 0, false, 0);
+}
+//----------------------------------------------------------
+
+void SevenSegmentPager::setTiming(uint16_t p, uint16_t s)
+{
+   pageTime   = p;
+   sampleTime = s;
+   redraw     = true;
+}
+//----------------------------------------------------------
+
+void SevenSegmentPager::show(uint8_t p)
+{
+   if (p >= count)   return;
+   current = p;
+   redraw  = true;
+}
+//----------------------------------------------------------
+
+void SevenSegmentPager::next()
+{
+   if (count)   show((current + 1 < count) ? current + 1 : 0);
+}
+//----------------------------------------------------------
+
+uint8_t SevenSegmentPager::page()
+{
+   return current;
+}
+//----------------------------------------------------------
+
+bool SevenSegmentPager::tick()
+{
+   return tick(millis());
+}
+//----------------------------------------------------------
+
+bool SevenSegmentPager::tick(uint32_t now)
+{
+   if (count == 0)   return false;
+
+   bool draw = redraw;
+   if (redraw)
+   {
+      redraw   = false;
+      nextPage = now + pageTime;
+   }
+   else if (pageTime && (count > 1) && ((int32_t)(now - nextPage) >= 0))
+   {
+      SevenSegmentTiming::advance(nextPage, pageTime, now);
+      current = (current + 1 < count) ? current + 1 : 0;
+      draw    = true;
+   }
+   if (!draw && ((int32_t)(now - nextSample) < 0))   return false;
+   nextSample = now + sampleTime;
+
+   // Only the visible source is asked for its value
+   int32_t value = pages[current].source();
+   if (!draw && (value == shown))   return false;
+
+   shown = value;
+   render(pages[current], value);
+   display.writeDisplay();
+   return true;
+}
+//----------------------------------------------------------
+
+
+//*********
+// private
+//*********
+
+bool SevenSegmentPager::add(Source source, uint8_t format, uint8_t param, bool padding, char label)
+{
+   if (!source || (count >= maxPages))   return false;
+
+   Page &p   = pages[count++];
+   p.source  = source;
+   p.format  = format;
+   p.param   = param;
+   p.padding = padding;
+   p.label   = label ? SevenSegmentBase::glyph(label) : 0x00;
+   if (count == 1)   redraw = true;  // First page, show it at once
+   return true;
+}
+//----------------------------------------------------------
+
+void SevenSegmentPager::render(const Page &p, int32_t value)
+{
+   uint8_t pos   = p.label ? 1 : 0;
+   uint8_t width = display.digits() - pos;
+
+   display.drawColon(p.format == formatTime);
+   switch (p.format)
+   {
+      case formatTime:
+         if ((value < 0) || (value > 9999) || !display.printTime(value / 100, value % 100))   display.drawLineMiddle();
+         return;
+      case formatFixed:
+         display.printFixedAt(pos, width, value, p.param);
+         break;
+      default:
+         display.printNumberAt(pos, width, value, p.param, p.padding);
+   }
+   if (p.label)   display.drawSegments(0, p.label);
+}
+//----------------------------------------------------------
@@ -0,0 +1,119 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         SevenSegmentPager.h
+ * Description:  Several readings on one seven segment display, one page at a time
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage:
+ *  The pager shows one reading (a page) at a time and flips to the next page on a timer. Each page has
+ *  a source: a function without arguments that returns the value as an int32_t. Only the source of the
+ *  visible page is called, and the display is only drawn and written when the page flips or when the
+ *  value differs from the one shown. A value that doesn't change costs no drawing and no I2C.
+ *
+ *  Initialise with SevenSegmentPager pager = SevenSegmentPager(display), then add the pages:
+ *
+ *     int32_t readTemperature() { return sensor.read() * 10; }  // 0.1 degrees
+ *     pager.addFixed(readTemperature, 1, 't');
+ *
+ *  addNumber(source, base = 10, padding = false, label = 0)
+ *     the value like printNumber(value, base, padding)
+ *  addFixed(source, decimals, label = 0)
+ *     the value like printFixed(value, decimals)
+ *  addTime(source)
+ *     the value as first * 100 + last, like printTime(first, last) with the colon on. So 1234 is 12:34.
+ *     Values below 0 or above 9999 show the middle line
+ *  With a label the character 'label' is drawn on the first digit and the value on the other digits.
+ *  Time pages have no label. All return false if there are already SevenSegmentPager::maxPages pages
+ *
+ *  setTiming(pageTime, sampleTime = 100)
+ *     show each page for 'pageTime' ms, 0 to only change pages with show() or next(). The source of the
+ *     visible page is called every 'sampleTime' ms. The default is 3000 and 100 ms
+ *  show(page) and next()
+ *     show the page with index 'page' (0 is the first page added) or the next page, and restart the page time
+ *  page()
+ *     the index of the visible page
+ *  tick() or tick(now)
+ *     call this from loop(). Returns at once when nothing is due, returns true if the display was written.
+ *     'now' is the time in milliseconds, default millis()
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#ifndef SEVENSEGMENTPAGER_H
+#define SEVENSEGMENTPAGER_H
+
+#include <Arduino.h>
+#include <SevenSegment.h>
+
+
+class SevenSegmentPager
+{
+   public:
+      typedef int32_t (*Source)();
+
+      static const uint8_t maxPages = 8;
+
+      SevenSegmentPager(SevenSegmentBase &display);
+
+      bool    addNumber(Source source, uint8_t base = 10, bool padding = false, char label = 0);
+      bool    addFixed(Source source, uint8_t decimals, char label = 0);
+      bool    addTime(Source source);
+      void    setTiming(uint16_t pageTime, uint16_t sampleTime = 100);
+      void    show(uint8_t page);
+      void    next();
+      uint8_t page();
+      bool    tick();
+      bool    tick(uint32_t now);
+
+   private:
+      static const uint8_t formatNumber = 0x00;
+      static const uint8_t formatFixed  = 0x01;
+      static const uint8_t formatTime   = 0x02;
+
+      struct Page
+      {
+         Source  source;
+         uint8_t format;
+         uint8_t param;     // Base or decimals
+         bool    padding;
+         uint8_t label;     // Segments of the label, 0 for none
+      };
+
+      SevenSegmentBase &display;
+      Page              pages[maxPages];
+      uint8_t           count      = 0;
+      uint8_t           current    = 0;
+      bool              redraw     = false;  // Draw the current page at the next tick
+      uint16_t          pageTime   = 3000;
+      uint16_t          sampleTime = 100;
+      uint32_t          nextPage;
+      uint32_t          nextSample;
+      int32_t           shown;               // Value on the display
+
+      bool add(Source source, uint8_t format, uint8_t param, bool padding, char label);
+      void render(const Page &page, int32_t value);
+};
+
+#endif // SEVENSEGMENTPAGER_H
@@ -0,0 +1,182 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         print_benchmark.ino
+ * Description:  Cycles of printNumber(), against the division based version it replaced
+ *
+ * This file is part of SevenSegment
+ *
+ * For a set of values and bases both versions draw the number, and the cycles each one takes are
+ * printed on Serial with the average per base. On AVR the cycles are counted with Timer 1 at the
+ * CPU clock. On other processors the time in ns per call is printed instead. "same" tells whether
+ * both versions drew the same segments. No display needs to be connected.
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+
+#include <Wire.h>
+#include <SevenSegment.h>
+
+// A SevenSegment that hands out a copy of its display buffer, to compare what both versions drew
+class BenchmarkDisplay : public SevenSegment
+{
+   public:
+      static const uint8_t bufferBytes = 2 * ht16k33::bufferSize;
+
+      void copyBuffer(uint8_t *copy)
+      {
+         memset(copy, 0, bufferBytes);
+         memcpy(copy, framebuffer, sizeof(framebuffer));
+      }
+};
+
+static BenchmarkDisplay display;
+
+static const int32_t values[] = { 0, 7, 42, 255, 1234, 9999, -5, -123, -1234, 65535, 100000 };
+static const uint8_t bases[]  = { DEC, HEX, OCT, BIN, 3 };
+static const uint8_t count    = sizeof(values) / sizeof(values[0]);
+
+
+// printNumber() before it was made division-free, for the comparison
+static bool oldPrintNumber(int32_t number, uint8_t base, bool padding)
+{
+   int8_t i = display.displayDigits - 1;
+   bool   lastDigitFree = false;
+   bool   negative = (number < 0);
+
+   display.clearDigits();
+   if ((base <= 1) || (base > HEX))  return false;
+   if (negative)   number = -number;  // Don't complicate things, work with positive numbers
+   do
+   {
+      if ((i == 0) && (number == 0))   lastDigitFree = true;
+      display.drawDigit(i-- , number % base);
+      number /= base;
+   } while (((number != 0) || padding) && (i >= 0));
+
+   if (i >= 0)   lastDigitFree = true;
+
+   // Check for overflow
+   if (number != 0)
+   {
+      if (negative)
+         display.drawLineLower();
+      else
+         display.drawLineUpper();
+      return false;
+   }
+
+   if (negative)
+   {
+      if (lastDigitFree)
+         display.drawHyphen(0);
+      else
+         display.drawDot(display.displayDigits - 1);
+   }
+   return true;
+}
+
+
+// Cycles (AVR) or ns per call (others, the us of 1000 calls) of one version
+static uint32_t measure(bool old, int32_t value, uint8_t base)
+{
+#if defined(__AVR__)
+   uint16_t start, end;
+
+   noInterrupts();
+   start = TCNT1;
+   if (old)
+      oldPrintNumber(value, base, false);
+   else
+      display.printNumber(value, base, false);
+   end = TCNT1;
+   interrupts();
+   return (uint16_t)(end - start);
+#else
+   uint32_t start = micros();
+
+   for (uint16_t i = 0; i < 1000; i++)
+   {
+      if (old)
+         oldPrintNumber(value, base, false);
+      else
+         display.printNumber(value, base, false);
+   }
+   return micros() - start;
+#endif
+}
+
+
+void setup()
+{
+   Serial.begin(115200);
+
+#if defined(__AVR__)
+   // Timer 1 counts CPU cycles
+   TCCR1A = 0;
+   TCCR1B = _BV(CS10);
+   Serial.println("base value old new cycles");
+#else
+   Serial.println("base value old new ns per call");
+#endif
+
+   for (uint8_t b = 0; b < sizeof(bases); b++)
+   {
+      uint32_t oldTotal = 0;
+      uint32_t newTotal = 0;
+
+      for (uint8_t v = 0; v < count; v++)
+      {
+         uint8_t  oldSegments[BenchmarkDisplay::bufferBytes];
+         uint8_t  newSegments[BenchmarkDisplay::bufferBytes];
+         uint32_t oldTime = measure(true, values[v], bases[b]);
+         uint32_t newTime;
+
+         display.copyBuffer(oldSegments);
+         newTime = measure(false, values[v], bases[b]);
+         display.copyBuffer(newSegments);
+         oldTotal += oldTime;
+         newTotal += newTime;
+
+         Serial.print(bases[b]);
+         Serial.print(' ');
+         Serial.print(values[v]);
+         Serial.print(' ');
+         Serial.print(oldTime);
+         Serial.print(' ');
+         Serial.print(newTime);
+         Serial.println(memcmp(oldSegments, newSegments, sizeof(oldSegments)) ? " different" : " same");
+      }
+      Serial.print("average base ");
+      Serial.print(bases[b]);
+      Serial.print(' ');
+      Serial.print(oldTotal / count);
+      Serial.print(' ');
+      Serial.println(newTotal / count);
+   }
+}
+
+void loop()
+{
+}
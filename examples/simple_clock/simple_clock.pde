@@ -12,6 +12,10 @@
  * File:         HT16K33-7Seg.ino
  * Description:  Example using the Seven Segment driver for HT16K33 LED Controller
  *
+ *               The clock shows the minutes and seconds since the start. It uses SevenSegmentClock,
+ *               so the minutes wrap from 59:59 to 00:00. Older versions of this example counted on
+ *               to 99:59 before wrapping.
+ *
  * This file is part of SevenSegment
  *
  * This program is free software: you can redistribute it and/or modify
@@ -31,6 +35,7 @@
 
 #include <Wire.h>
 #include <SevenSegment.h>
+#include <SevenSegmentClock.h>
 
 #define DISPLAY_ADDRESS 0x70
 
@@ -45,9 +50,8 @@
    #define debug_println(a) ;
 #endif
 
-static SevenSegment display = SevenSegment(DISPLAY_ADDRESS);
-static uint8_t minutes = 0;
-static uint8_t seconds = 0;
+static SevenSegment      display      = SevenSegment(DISPLAY_ADDRESS);
+static SevenSegmentClock displayClock = SevenSegmentClock(display);
 
 
 void setup()
@@ -66,28 +70,16 @@ void setup()
       testcode();
    #endif
    display.clearDisplay();
+
+   // Minutes and seconds since the start, with a blinking colon
+   displayClock.setFormat(SevenSegmentClock::formatMinSec);
+   displayClock.setTime(0, 0);
 }
 
 void loop()
 {
-   // Extremely simplistic clock
-   while (true)
-   {
-      display.printTime(minutes, seconds);
-      display.writeDisplay();
-      delay (500);
-      display.toggleColon();
-      display.writeColon();
-      delay (499);
-      display.toggleColon();
-      seconds++;
-      if (seconds > 59)
-      {
-         seconds = 0;
-         minutes++;
-         if (minutes > 99)   minutes = 0;
-      }
-   }
+   // Returns at once when there is nothing to update, there is time left for other work
+   displayClock.update();
 }
 
 #ifdef TEST_CODE
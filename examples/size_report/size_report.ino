@@ -0,0 +1,74 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         size_report.ino
+ * Description:  Flash and RAM footprint of the Seven Segment driver, per feature
+ *
+ * This file is part of SevenSegment
+ *
+ * Without any of the flags below only begin() and writeDisplay() are used, that is the baseline.
+ * Each flag adds one feature:
+ *    SIZE_PRINTNUMBER   printNumber()
+ *    SIZE_PRINTTIME     printTime()
+ *    SIZE_LINES         the line drawing functions
+ * Add HT16K33_PACKED_BUFFER to see the packed display buffer.
+ * extras/size_report.sh builds every combination with arduino-cli and prints a table.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+
+#include <Wire.h>
+#include <SevenSegment.h>
+
+#define DISPLAY_ADDRESS 0x70
+
+static SevenSegment display = SevenSegment(DISPLAY_ADDRESS);
+
+// Volatile, so the compiler can't work out the results at compile time
+static volatile int16_t value   = 1234;
+static volatile uint8_t minutes = 12;
+static volatile uint8_t seconds = 34;
+
+
+void setup()
+{
+   display.begin();
+}
+
+void loop()
+{
+   #ifdef SIZE_PRINTNUMBER
+      display.printNumber(value);
+   #endif
+   #ifdef SIZE_PRINTTIME
+      display.printTime(minutes, seconds);
+   #endif
+   #ifdef SIZE_LINES
+      display.drawLineUpper();
+      display.drawLineMiddle();
+      display.drawLineLower();
+      display.drawLines2();
+      display.drawLines3();
+   #endif
+   display.writeDisplay();
+}
@@ -0,0 +1,108 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         Arduino.h
+ * Description:  The part of the Arduino core used by SevenSegment, for host builds
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage:
+ *  Only for the programs in extras/host and the example sketches, see build.sh. Time does not pass by
+ *  itself: millis() and micros() return hostTime (in us), which the programs set or advance. With
+ *  hostRealTime the time of the host is added, for benchmarks.
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define PROGMEM
+#define F(text)  ((const __FlashStringHelper *)(text))
+
+#define HIGH     0x1
+#define LOW      0x0
+#define INPUT    0x0
+#define OUTPUT   0x1
+#define INPUT_PULLUP 0x2
+
+#define BIN      2
+#define OCT      8
+#define DEC      10
+#define HEX      16
+
+class __FlashStringHelper;
+
+inline uint8_t pgm_read_byte(const void *p)   { return *(const uint8_t *)p; }
+inline void   *memcpy_P(void *dest, const void *src, size_t n)   { return memcpy(dest, src, n); }
+
+extern uint32_t hostTime;      // us
+extern bool     hostRealTime;  // Add the time of the host
+
+unsigned long micros();
+inline unsigned long millis()   { return micros() / 1000; }
+inline void delay(unsigned long ms)   { hostTime += ms * 1000; }
+inline void delayMicroseconds(unsigned int us)   { hostTime += us; }
+
+inline void noInterrupts()   {}
+inline void interrupts()     {}
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int  digitalRead(uint8_t pin);
+
+
+class Print
+{
+   public:
+      size_t print(const char *text);
+      size_t print(char c);
+      size_t print(unsigned char n, int base = DEC)   { return print((unsigned long)n, base); }
+      size_t print(int n, int base = DEC)             { return print((long)n, base); }
+      size_t print(unsigned int n, int base = DEC)    { return print((unsigned long)n, base); }
+      size_t print(long n, int base = DEC);
+      size_t print(unsigned long n, int base = DEC);
+      size_t println();
+      template <typename T> size_t println(T value)   { return print(value) + println(); }
+
+   protected:
+      virtual size_t write(uint8_t c) = 0;
+};
+
+
+class HostSerial : public Print
+{
+   public:
+      void begin(unsigned long)   {}
+
+   protected:
+      size_t write(uint8_t c);
+};
+
+extern HostSerial Serial;
+
+#endif // ARDUINO_H
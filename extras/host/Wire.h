@@ -0,0 +1,94 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         Wire.h
+ * Description:  Recording stand-in for the Wire library, for host builds
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage:
+ *  A TwoWire with the interface the driver uses. Every transaction is counted and written to the
+ *  display RAM, key RAM and register pointer of a simulated HT16K33, so reads return what was written.
+ *
+ *  reset()
+ *     set the counters to 0
+ *  transactions, bytes
+ *     the number of transactions and the bytes on the bus, address bytes included
+ *  busTime(clock)
+ *     the time in us these transactions take at 'clock' Hz: 9 clocks per byte (8 bits and the
+ *     acknowledge) plus 1 for the start and 1 for the stop condition of each transaction
+ *  log
+ *     print every transaction when true
+ *  fail
+ *     when true every transaction is not acknowledged
+ *  ram
+ *     the RAM of the simulated HT16K33: display RAM at 0x00, key RAM at 0x40
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#ifndef WIRE_H
+#define WIRE_H
+
+#include <Arduino.h>
+
+
+class TwoWire
+{
+   public:
+      static const uint8_t ramSize = 0x50;
+
+      uint32_t transactions = 0;
+      uint32_t bytes        = 0;
+      bool     log          = false;
+      bool     fail         = false;
+      uint8_t  ram[ramSize] = {};
+
+      void     begin();
+      void     setClock(uint32_t clock);
+      void     beginTransmission(uint8_t address);
+      size_t   write(uint8_t b);
+      uint8_t  endTransmission(bool stop = true);
+      uint8_t  requestFrom(uint8_t address, uint8_t n);
+      int      available();
+      int      read();
+
+      void     reset();
+      uint32_t busTime(uint32_t clock);
+
+   private:
+      static const uint8_t maxBuffer = 32;
+
+      uint8_t address;
+      uint8_t buffer[maxBuffer];
+      uint8_t length;
+      uint8_t pointer = 0;         // Register pointer of the HT16K33
+      uint8_t rxLength = 0;
+      uint8_t rxPos    = 0;
+
+      void count(uint8_t n);
+};
+
+extern TwoWire Wire;
+
+#endif // WIRE_H
@@ -0,0 +1,29 @@
+#!/bin/sh
+#
+# Host builds of the Seven Segment driver
+# Builds the library with extras/host/<program>.cpp, or with the example sketch examples/<program>,
+# against the Arduino and Wire stand-ins in extras/host, using the host compiler (CXX, default c++),
+# and runs it. A sketch runs setup() and loop() once. Nothing is written in the tree.
+#
+# Usage: extras/host/build.sh <program> [arguments]
+#    bus_cost          transactions, bytes and bus time of each API call, checks for extra bus traffic
+#    render_check      decodes what printNumber() and printTime() draw and checks it, renders per second
+#    print_benchmark   the example sketch: printNumber() against the division based version
+#
+
+PROGRAM=${1:?usage: $0 <program> [arguments]}
+shift
+HOST=$(cd "$(dirname "$0")" && pwd)
+LIBRARY=$(cd "$HOST/../.." && pwd)
+OUTPUT="${TMPDIR:-/tmp}/sevensegment-$PROGRAM"
+
+if [ -f "$HOST/$PROGRAM.cpp" ]
+then
+   SOURCES="$HOST/$PROGRAM.cpp"
+else
+   SOURCES="$HOST/sketch.cpp -x c++ $(ls "$LIBRARY/examples/$PROGRAM/$PROGRAM".ino "$LIBRARY/examples/$PROGRAM/$PROGRAM".pde 2>/dev/null) -x none"
+fi
+
+${CXX:-c++} -std=gnu++11 -O2 -Wall -Wextra -I"$HOST" -I"$LIBRARY" -o "$OUTPUT" \
+   "$HOST/host.cpp" "$LIBRARY"/*.cpp $SOURCES || exit 1
+exec "$OUTPUT" "$@"
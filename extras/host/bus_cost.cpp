@@ -0,0 +1,94 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         bus_cost.cpp
+ * Description:  I2C cost of each API call, on the host
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage:
+ *  extras/host/build.sh bus_cost [-v]
+ *  Prints the transactions, bytes and bus time at 100 and 400 kHz of each call, in the order of the
+ *  table, so each call starts from the display the previous ones left. -v prints every transaction.
+ *  Calls that must not cause bus traffic, or only a limited amount, are checked: the exit status is
+ *  the number of failed checks.
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <Wire.h>
+#include <SevenSegment.h>
+
+static const uint32_t noLimit = 0xFFFFFFFF;
+
+static SevenSegment display;
+static int          failures = 0;
+
+
+// Run 'action', print its cost and check it used at most 'maxTransactions' and 'maxBytes'
+static void cost(const char *call, void (*action)(), uint32_t maxTransactions = noLimit, uint32_t maxBytes = noLimit)
+{
+   if (Wire.log)   printf("%s\n", call);
+   Wire.reset();
+   action();
+
+   bool ok = (Wire.transactions <= maxTransactions) && (Wire.bytes <= maxBytes);
+   printf("%-46s %5u %6u %8u %8u  %s\n", call, (unsigned)Wire.transactions, (unsigned)Wire.bytes,
+          (unsigned)Wire.busTime(100000), (unsigned)Wire.busTime(400000),
+          ok ? "" : "FAIL");
+   if (!ok)   failures++;
+}
+//----------------------------------------------------------
+
+
+int main(int argc, char **argv)
+{
+   Wire.log = (argc > 1) && (strcmp(argv[1], "-v") == 0);
+
+   printf("%-46s %5s %6s %8s %8s\n", "call", "trans", "bytes", "us@100k", "us@400k");
+
+   cost("begin()",                              [] { display.begin(); });
+   cost("writeDisplay(), nothing changed",      [] { display.writeDisplay(); }, 0);
+   cost("printNumber(1234) writeDisplay()",     [] { display.printNumber(1234); display.writeDisplay(); });
+   cost("printNumber(1235) writeDisplay()",     [] { display.printNumber(1235); display.writeDisplay(); }, 1, 3);
+   cost("printTime(12, 34) writeDisplay()",     [] { display.printTime(12, 34); display.writeDisplay(); });
+   cost("drawColon() writeColon()",             [] { display.drawColon(); display.writeColon(); });
+   cost("toggleColon() writeColon()",           [] { display.toggleColon(); display.writeColon(); });
+   cost("printNumber(5678) toggleColon() writeColon()", [] { display.printNumber(5678); display.toggleColon(); display.writeColon(); }, 1, 4);
+   cost("writeDisplay(), the digits",           [] { display.writeDisplay(); });
+   cost("printString(\"HELP\") writeDisplay()", [] { display.printString("HELP"); display.writeDisplay(); });
+   cost("drawLines3() writeDisplay()",          [] { display.drawLines3(); display.writeDisplay(); });
+   cost("setBrightness(8)",                     [] { display.setBrightness(8); }, 1, 2);
+   cost("setBlinkRate(blink_1Hz)",              [] { display.setBlinkRate(SevenSegment::blink_1Hz); }, 1, 2);
+   cost("setDisplayStatus(displayOn)",          [] { display.setDisplayStatus(SevenSegment::displayOn); }, 1, 2);
+   cost("clearDisplay()",                       [] { display.clearDisplay(); }, 0);
+   cost("clearDisplay() writeDisplay()",        [] { display.clearDisplay(); display.writeDisplay(); });
+   cost("scrub()",                              [] { display.scrub(); });
+   cost("async printNumber(42) writeDisplay()", [] { display.setAsync(true); display.printNumber(42); display.writeDisplay(); }, 0);
+   cost("async service() until done",           [] { while (display.service()) ; display.setAsync(false); });
+
+   printf("%d check(s) failed\n", failures);
+   return failures;
+}
@@ -0,0 +1,231 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         host.cpp
+ * Description:  Arduino core and Wire stand-ins for host builds
+ *
+ * This file is part of SevenSegment
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#include <stdio.h>
+#include <chrono>
+#include <Arduino.h>
+#include <Wire.h>
+
+uint32_t   hostTime     = 0;
+bool       hostRealTime = false;
+HostSerial Serial;
+TwoWire    Wire;
+
+
+//*********
+// Arduino
+//*********
+
+unsigned long micros()
+{
+   static const auto start = std::chrono::steady_clock::now();
+
+   if (!hostRealTime)   return hostTime;
+   return hostTime + std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+//----------------------------------------------------------
+
+void pinMode(uint8_t, uint8_t)
+{
+}
+//----------------------------------------------------------
+
+void digitalWrite(uint8_t, uint8_t)
+{
+}
+//----------------------------------------------------------
+
+int digitalRead(uint8_t)
+{
+   return HIGH;
+}
+//----------------------------------------------------------
+
+size_t Print::print(const char *text)
+{
+   size_t n = 0;
+   while (*text)   n += write(*text++);
+   return n;
+}
+//----------------------------------------------------------
+
+size_t Print::print(char c)
+{
+   return write(c);
+}
+//----------------------------------------------------------
+
+size_t Print::print(long n, int base)
+{
+   if (n >= 0)   return print((unsigned long)n, base);
+   return print('-') + print(0 - (unsigned long)n, base);
+}
+//----------------------------------------------------------
+
+size_t Print::print(unsigned long n, int base)
+{
+   char   text[33];
+   char  *p = text + sizeof(text) - 1;
+
+   *p = 0;
+   do
+   {
+      *--p = "0123456789ABCDEF"[n % base];
+      n   /= base;
+   } while (n);
+   return print(p);
+}
+//----------------------------------------------------------
+
+size_t Print::println()
+{
+   return write('\n');
+}
+//----------------------------------------------------------
+
+size_t HostSerial::write(uint8_t c)
+{
+   putchar(c);
+   return 1;
+}
+//----------------------------------------------------------
+
+
+//*********
+// TwoWire
+//*********
+
+void TwoWire::begin()
+{
+}
+//----------------------------------------------------------
+
+void TwoWire::setClock(uint32_t)
+{
+}
+//----------------------------------------------------------
+
+void TwoWire::beginTransmission(uint8_t a)
+{
+   address = a;
+   length  = 0;
+}
+//----------------------------------------------------------
+
+size_t TwoWire::write(uint8_t b)
+{
+   if (length >= maxBuffer)   return 0;
+   buffer[length++] = b;
+   return 1;
+}
+//----------------------------------------------------------
+
+uint8_t TwoWire::endTransmission(bool)
+{
+   if (log)
+   {
+      printf("  W %02X:", address);
+      for (uint8_t i = 0; i < length; i++)   printf(" %02X", buffer[i]);
+      printf(fail ? " NACK\n" : "\n");
+   }
+   if (fail)
+   {
+      count(0);   // Only the address was sent
+      return 2;
+   }
+   count(length);
+
+   // Display RAM writes and address pointer commands, other commands only set the pointer aside
+   if (length && (buffer[0] < 0x10))
+   {
+      pointer = buffer[0];
+      for (uint8_t i = 1; i < length; i++)   ram[(pointer++) & 0x0F] = buffer[i];
+   }
+   else if (length && (buffer[0] >= 0x40) && (buffer[0] < 0x50))
+      pointer = buffer[0];
+   return 0;
+}
+//----------------------------------------------------------
+
+uint8_t TwoWire::requestFrom(uint8_t a, uint8_t n)
+{
+   rxPos    = 0;
+   rxLength = fail ? 0 : n;
+   count(rxLength);
+   if (log)
+   {
+      printf("  R %02X:", a);
+      for (uint8_t i = 0; i < rxLength; i++)   printf(" %02X", ram[(pointer + i) % ramSize]);
+      printf(fail ? " NACK\n" : "\n");
+   }
+   return rxLength;
+}
+//----------------------------------------------------------
+
+int TwoWire::available()
+{
+   return rxLength - rxPos;
+}
+//----------------------------------------------------------
+
+int TwoWire::read()
+{
+   if (rxPos >= rxLength)   return -1;
+   rxPos++;
+   return ram[(pointer++) % ramSize];
+}
+//----------------------------------------------------------
+
+void TwoWire::reset()
+{
+   transactions = 0;
+   bytes        = 0;
+}
+//----------------------------------------------------------
+
+uint32_t TwoWire::busTime(uint32_t clock)
+{
+   uint32_t clocks = 9 * bytes + 2 * transactions;
+   return (uint32_t)(((uint64_t)clocks * 1000000 + clock - 1) / clock);
+}
+//----------------------------------------------------------
+
+
+//*********
+// private
+//*********
+
+void TwoWire::count(uint8_t n)
+{
+   transactions++;
+   bytes += n + 1;  // The address byte
+}
+//----------------------------------------------------------
@@ -0,0 +1,207 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         render_check.cpp
+ * Description:  Checks what printNumber() and printTime() draw, on the host
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage:
+ *  extras/host/build.sh render_check
+ *  Draws every value from -9999 to 99999 with printNumber() in each base from 2 to 16, with and without
+ *  padding, and every time from 00:00 to 99:99 (and a few invalid ones) with printTime(). The digits
+ *  are read back with readRaw(), turned into text by a 7-segment decoder of its own and compared with
+ *  the text a reference formatter expects, as is the return value. Prints the first mismatches and the
+ *  number of renders per second. The exit status is 1 if anything was wrong.
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <Wire.h>
+#include <SevenSegment.h>
+
+static const uint8_t  digits        = SevenSegment::displayDigits;
+static const int32_t  firstValue    = -9999;
+static const int32_t  lastValue     = 99999;
+static const uint32_t maxReported   = 10;
+
+static SevenSegment display;
+static uint32_t     renders  = 0;
+static uint32_t     failures = 0;
+
+
+// The character shown by a digit, without its dot. Segments a..g are bits 0..6
+static char decode(uint8_t segments)
+{
+   static const struct { uint8_t segments; char c; } shapes[] =
+   {
+      { 0x3F, '0' }, { 0x06, '1' }, { 0x5B, '2' }, { 0x4F, '3' }, { 0x66, '4' }, { 0x6D, '5' },
+      { 0x7D, '6' }, { 0x07, '7' }, { 0x7F, '8' }, { 0x6F, '9' }, { 0x77, 'A' }, { 0x7C, 'B' },
+      { 0x39, 'C' }, { 0x5E, 'D' }, { 0x79, 'E' }, { 0x71, 'F' },
+      { 0x00, ' ' }, { 0x40, '-' }, { 0x01, '^' }, { 0x08, '_' }   // ^ is the overflow line at the top
+   };
+
+   for (uint8_t i = 0; i < sizeof(shapes) / sizeof(shapes[0]); i++)
+      if (shapes[i].segments == (segments & 0x7F))   return shapes[i].c;
+   return '?';
+}
+//----------------------------------------------------------
+
+// The display as text, a dot follows the character of its digit
+static void readDisplay(char *text)
+{
+   uint8_t segments[digits];
+   uint8_t n = display.readRaw(segments, digits);
+
+   for (uint8_t i = 0; i < n; i++)
+   {
+      *text++ = decode(segments[i]);
+      if (segments[i] & 0x80)   *text++ = '.';
+   }
+   *text = '\0';
+}
+//----------------------------------------------------------
+
+// What printNumber(value, base, padding) should show, and its return value
+static bool expectNumber(int32_t value, uint8_t base, bool padding, char *text)
+{
+   bool     negative  = (value < 0);
+   uint32_t magnitude = negative ? 0 - (uint32_t)value : value;
+   char     number[33];
+   uint8_t  length = 0;
+
+   do
+   {
+      number[length++] = "0123456789ABCDEF"[magnitude % base];
+      magnitude /= base;
+   } while (magnitude);
+
+   if (length > digits)
+   {
+      memset(text, negative ? '_' : '^', digits);
+      text[digits] = '\0';
+      return false;
+   }
+
+   // Right aligned, padded with zeros or spaces
+   for (uint8_t i = 0; i < digits; i++)
+      text[i] = (i < digits - length) ? (padding ? '0' : ' ') : number[digits - 1 - i];
+   text[digits] = '\0';
+
+   // The sign takes the first digit if that is free, otherwise it is the dot of the last digit
+   if (negative)
+   {
+      if (length < digits)
+         text[0] = '-';
+      else
+      {
+         text[digits]     = '.';
+         text[digits + 1] = '\0';
+      }
+   }
+   return true;
+}
+//----------------------------------------------------------
+
+// What printTime(first, last) should show, and its return value
+static bool expectTime(uint8_t first, uint8_t last, char *text)
+{
+   if ((first > 99) || (last > 99))
+   {
+      memset(text, ' ', digits);
+      text[digits] = '\0';
+      return false;
+   }
+   sprintf(text, "%02u%02u", first, last);
+   return true;
+}
+//----------------------------------------------------------
+
+// Compare the display and 'result' with what is expected, the call is only formatted when reported
+static void check(bool result, bool expectedResult, const char *expected, const char *call, ...)
+{
+   char    shown[2 * digits + 1];
+   char    text[40];
+   va_list args;
+
+   renders++;
+   readDisplay(shown);
+   if ((result == expectedResult) && (strcmp(shown, expected) == 0))   return;
+   if (++failures > maxReported)   return;
+
+   va_start(args, call);
+   vsnprintf(text, sizeof(text), call, args);
+   va_end(args);
+   printf("%-32s shows \"%s\" returns %d, expected \"%s\" returns %d\n",
+          text, shown, result, expected, expectedResult);
+}
+//----------------------------------------------------------
+
+
+int main()
+{
+   char expected[2 * digits + 1];
+
+   display.begin();
+   auto start = std::chrono::steady_clock::now();
+
+   for (uint8_t base = 2; base <= 16; base++)
+      for (uint8_t padding = 0; padding <= 1; padding++)
+         for (int32_t value = firstValue; value <= lastValue; value++)
+         {
+            bool result = display.printNumber(value, base, padding);
+            bool expect = expectNumber(value, base, padding, expected);
+
+            check(result, expect, expected, "printNumber(%ld, %u, %s)", (long)value, base, padding ? "true" : "false");
+         }
+
+   // The extremes, where negating has to be done without overflow
+   static const int32_t extremes[] = { INT32_MIN, INT32_MIN + 1, INT32_MAX };
+   for (uint8_t i = 0; i < sizeof(extremes) / sizeof(extremes[0]); i++)
+      for (uint8_t base = 2; base <= 16; base++)
+      {
+         bool result = display.printNumber(extremes[i], base);
+         bool expect = expectNumber(extremes[i], base, false, expected);
+
+         check(result, expect, expected, "printNumber(%ld, %u)", (long)extremes[i], base);
+      }
+
+   for (uint16_t first = 0; first <= 101; first++)
+      for (uint16_t last = 0; last <= 101; last++)
+      {
+         bool result = display.printTime(first, last);
+         bool expect = expectTime(first, last, expected);
+
+         check(result, expect, expected, "printTime(%u, %u)", first, last);
+      }
+
+   double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   printf("%lu renders in %.2f s, %.0f renders/s (decoding included)\n",
+          (unsigned long)renders, seconds, renders / seconds);
+   printf("%lu mismatch(es)\n", (unsigned long)failures);
+   return failures ? 1 : 0;
+}
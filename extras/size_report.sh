@@ -0,0 +1,37 @@
+#!/bin/sh
+#
+# Flash and RAM footprint of the Seven Segment driver, per feature
+# Builds examples/size_report with arduino-cli for every feature, with and without
+# HT16K33_PACKED_BUFFER, and prints the sizes and the difference with the baseline.
+#
+# Usage: extras/size_report.sh [fqbn]     default fqbn: arduino:avr:uno
+#
+
+FQBN=${1:-arduino:avr:uno}
+LIBRARY=$(cd "$(dirname "$0")/.." && pwd)
+SKETCH="$LIBRARY/examples/size_report"
+
+# Prints "<flash> <ram>" for the given compiler flags
+build()
+{
+   arduino-cli compile --clean --fqbn "$FQBN" --library "$LIBRARY" \
+      --build-property "compiler.cpp.extra_flags=$1" "$SKETCH" |
+   awk '/^Sketch uses/ { flash = $3 } /^Global variables use/ { ram = $4 } END { print flash, ram }'
+}
+
+printf "%-16s %-8s %8s %8s %8s %8s\n" "feature" "buffer" "flash" "ram" "+flash" "+ram"
+for buffer in normal packed
+do
+   if [ "$buffer" = packed ]; then packed="-DHT16K33_PACKED_BUFFER"; else packed=""; fi
+
+   set -- $(build "$packed")
+   baseFlash=$1; baseRam=$2
+   printf "%-16s %-8s %8s %8s\n" "baseline" "$buffer" "$baseFlash" "$baseRam"
+
+   for feature in PRINTNUMBER PRINTTIME LINES
+   do
+      set -- $(build "$packed -DSIZE_$feature")
+      printf "%-16s %-8s %8s %8s %8s %8s\n" "$feature" "$buffer" "$1" "$2" \
+         "$(($1 - baseFlash))" "$(($2 - baseRam))"
+   done
+done
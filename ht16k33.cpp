@@ -36,6 +36,8 @@
 #include <Wire.h>
 #include "ht16k33.h"
 
+ht16k33TwoWire ht16k33::defaultBus;
+
 
 //********
 // public
@@ -49,13 +51,22 @@ ht16k33::ht16k33(uint8_t i2c_addr)
 
 void ht16k33::begin(void)
 {
-   Wire.begin();
+   bus->begin();
+   begins++;
+   failures     = 0;
+   backoffShift = 0;
+   standby  = false;
+   invalidateDisplay();            // Display RAM contents are unknown after power up
 
    writeByte(cmd_turnOn);          // Turn on oscillator
-   clearDisplay();                 // Clear display
+   for (uint8_t i = 0; i < displaybufSize; i++)   displaybuffer[i] = drawbuffer[i] = 0x00;  // Clear both buffers
+   writeDisplay();
    setBlinkRate(blink_Off);        // No blinking
    setBrightness(maxBrightness);   // Max brightness
    setDisplayStatus(displayOn);    // Turn on the display
+   if (keySetup)   queue(pendingKeys);  // Keys set up before, see ht16k33Keys
+
+   while (service()) ;             // Even in asynchronous mode, the display is ready when begin() returns
 }
 //----------------------------------------------------------
 
@@ -69,30 +80,220 @@ void ht16k33::begin(uint8_t i2c_addr)
 void ht16k33::setDisplayStatus(uint8_t s)
 {
    displayStatus = s ? displayOn : displayOff;
-   writeByte(cmd_displaySetup | displayStatus | blinkRate); 
+   queue(pendingSetup);
 }
 //----------------------------------------------------------
 
 void ht16k33::setBlinkRate(uint8_t br)
 {
    if (br > blink_0_5Hz)   br = blink_Off; // turn off if not sure
-   blinkRate = br << 1;
-   writeByte(cmd_displaySetup | displayStatus | blinkRate); 
+   blinkSetup = br << 1;
+   queue(pendingSetup);
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33::blinkRate()
+{
+   return blinkSetup >> 1;
 }
 //----------------------------------------------------------
 
-void ht16k33::setBrightness(uint8_t brightness)
+void ht16k33::setBrightness(uint8_t b)
 {
-   if (brightness > maxBrightness)   brightness = maxBrightness;
-   writeByte(cmd_brightness | brightness);
+   if (b > maxBrightness)   b = maxBrightness;
+   brightness = b;
+   queue(pendingBrightness);
 }
 //----------------------------------------------------------
 
 void ht16k33::clearDisplay()
 {
    // Clear buffer
-   for (int i = 0; i < displaybufSize; i++)  displaybuffer[i] = 0x00;
-   writeDisplay();  // Write the buffer
+   for (int i = 0; i < displaybufSize; i++)  drawbuffer[i] = 0x00;
+}
+//----------------------------------------------------------
+
+void ht16k33::setBus(ht16k33Bus &b)
+{
+   bus = &b;
+}
+//----------------------------------------------------------
+
+#ifdef HT16K33_BUS_STATS
+const ht16k33::busStats &ht16k33::stats()
+{
+   return statistics;
+}
+//----------------------------------------------------------
+
+void ht16k33::resetStats()
+{
+   statistics = busStats();
+}
+//----------------------------------------------------------
+#endif
+
+bool ht16k33::online()
+{
+   return failures < maxFailures;
+}
+//----------------------------------------------------------
+
+bool ht16k33::scrub(uint8_t bytes)
+{
+   uint8_t data[displayRamSize];
+   uint8_t end = displayRows << 1;
+
+   if (scrubAddr >= end)   scrubAddr = 0;
+   if (bytes > end - scrubAddr)   bytes = end - scrubAddr;
+   if (bytes == 0)   return true;
+
+   uint8_t first = scrubAddr;
+   scrubAddr += bytes;
+   if (!readBytes(first, data, bytes))   return false;
+
+   // Compare with what was sent, bytes not sent yet can't be wrong
+   bool repaired = false;
+   for (uint8_t i = 0; i < bytes; i++)
+   {
+      uint8_t  addr = first + i;
+      uint16_t mask = (1u << addr);
+
+      if (!byteUsed(addr) || ((staleMask | queuedMask) & mask))   continue;
+      if (data[i] != chipbuffer[packedBuffer ? addr >> 1 : addr])
+      {
+         staleMask |= mask;
+         repaired   = true;
+      }
+   }
+
+   if (repaired)
+   {
+      // Whatever corrupted the RAM may have reset the HT16K33 too
+      writeByte(standby ? cmd_turnOff : cmd_turnOn);
+      queue(allSettings());
+   }
+   return !repaired;
+}
+//----------------------------------------------------------
+
+void ht16k33::setBackBuffer(bufferRow *buffer)
+{
+   // The internal buffer becomes the front buffer, the drawing continues where it was
+   if (buffer)
+   {
+      for (uint8_t i = 0; i < displaybufSize; i++)   buffer[i] = drawbuffer[i];
+      for (uint8_t i = 0; i < displaybufSize; i++)   framebuffer[i] = displaybuffer[i];
+   }
+   else
+      for (uint8_t i = 0; i < displaybufSize; i++)   framebuffer[i] = drawbuffer[i];
+
+   noInterrupts();
+   displaybuffer = framebuffer;
+   drawbuffer    = buffer ? buffer : framebuffer;
+   interrupts();
+}
+//----------------------------------------------------------
+
+void ht16k33::present(bool keep)
+{
+   if (drawbuffer != displaybuffer)
+   {
+      bufferRow *drawn = drawbuffer;
+
+      noInterrupts();
+      drawbuffer    = displaybuffer;
+      displaybuffer = drawn;
+      interrupts();
+
+      if (keep)
+         for (uint8_t i = 0; i < displaybufSize; i++)   drawbuffer[i] = displaybuffer[i];
+   }
+   writeDisplay();
+}
+//----------------------------------------------------------
+
+void ht16k33::setAsync(bool async)
+{
+   asyncMode = async;
+   if (!asyncMode)   while (service()) ;  // Don't leave anything behind
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33::service(uint8_t maxBytes)
+{
+   // A display that stopped answering only gets a restart attempt now and then
+   if (!online())   return restart() ? 1 : 0;
+
+#ifdef HT16K33_ISR_INDICATORS
+   // Indicators changed by an interrupt, a change after this is sent by the next call
+   if (overlayDirty)
+   {
+      overlayDirty = false;
+      setPending(pendingDisplay);
+   }
+#endif
+
+   // Send at most one transaction per call, control registers before display RAM
+   if (pending & pendingSetup)
+   {
+      clearPending(pendingSetup);
+      if (!writeByte(cmd_displaySetup | displayStatus | blinkSetup))   setPending(pendingSetup);
+      return 1;
+   }
+   if (pending & pendingBrightness)
+   {
+      clearPending(pendingBrightness);
+      if (!writeByte(cmd_brightness | brightness))   setPending(pendingBrightness);
+      return 1;
+   }
+   if (pending & pendingKeys)
+   {
+      clearPending(pendingKeys);
+      if (!writeByte(keySetup))   setPending(pendingKeys);
+      return 1;
+   }
+   uint8_t display = pending & (pendingDisplay | pendingRange);
+   if (display)
+   {
+      uint8_t first, last;
+      bool    queuedOnly = !(display & pendingDisplay);   // writeRange() only
+
+      // Cleared before looking, so a writeDisplay() from an interrupt in between is not lost
+      clearPending(display);
+      if (maxBytes < 2)   maxBytes = 2;  // Address and at least 1 data byte
+      if (nextRange(first, last, maxBytes - 1, queuedOnly))
+      {
+         setPending(display);
+         sendRange(first, last);
+         return last - first + 2;
+      }
+   }
+   return 0;
+}
+//----------------------------------------------------------
+
+bool ht16k33::busy()
+{
+#ifdef HT16K33_ISR_INDICATORS
+   if (overlayDirty)   return true;
+#endif
+   return pending != 0;
+}
+//----------------------------------------------------------
+
+void ht16k33::writeDisplay()
+{
+   queue(pendingDisplay);
+}
+//----------------------------------------------------------
+
+
+void ht16k33::setBlankRows(uint8_t rows)
+{
+   if (rows == blankRows)   return;
+   blankRows = rows;
+   writeDisplay();
 }
 //----------------------------------------------------------
 
@@ -101,24 +302,286 @@ void ht16k33::clearDisplay()
 // protected
 //***********
 
-void ht16k33::writeByte(uint8_t b)
+bool ht16k33::writeByte(uint8_t b)
 {
-   Wire.beginTransmission(i2c_address);
-   Wire.write(b);
-   Wire.endTransmission();  
+   return writeBytes(&b, 1);
 }
 //----------------------------------------------------------
 
-void ht16k33::writeDisplay()
+bool ht16k33::readBytes(uint8_t addr, uint8_t *data, uint8_t n)
+{
+   if (!online())   return false;
+
+   uint32_t start = transactionStart();
+   return record(bus->read(i2c_address, addr, data, n), n + 1, start);
+}
+//----------------------------------------------------------
+
+void ht16k33::writeRange(uint8_t first, uint8_t last)
+{
+   // first and last are display RAM byte addresses, 2 per displaybuffer entry
+   // These bytes are sent even if they did not change, other changes wait for writeDisplay()
+   for (uint8_t addr = first; addr <= last; addr++)   queuedMask |= (1u << addr);
+   queue(pendingRange);
+}
+//----------------------------------------------------------
+
+void ht16k33::invalidateDisplay()
+{
+   // Next writeDisplay() will write the whole display RAM
+   staleMask = 0xFFFF;
+}
+//----------------------------------------------------------
+
+#ifdef HT16K33_ISR_INDICATORS
+void ht16k33::overlayWrite(uint8_t row, uint8_t mask, uint8_t bits)
+{
+   // Sequence lock: odd while changing, so a reader can tell its copy may be torn
+   if (row >= displaybufSize)   return;
+   overlaySeq++;
+   overlay[row] = (overlay[row] & ~mask) | (bits & mask);
+   overlaySeq++;
+   overlayDirty = true;
+}
+//----------------------------------------------------------
+
+void ht16k33::overlayToggle(uint8_t row, uint8_t mask)
+{
+   if (row >= displaybufSize)   return;
+   overlaySeq++;
+   overlay[row] ^= mask;
+   overlaySeq++;
+   overlayDirty = true;
+}
+//----------------------------------------------------------
+#endif
+
+
+//*********
+// private
+//*********
+
+void ht16k33::queue(uint8_t what)
+{
+   // A newer update of the same kind replaces an older one still waiting
+   setPending(what);
+   if (!asyncMode)   while (service()) ;
+}
+//----------------------------------------------------------
+
+void ht16k33::setPending(uint8_t what)
 {
-   Wire.beginTransmission(i2c_address);
-   Wire.write((uint8_t)0x00); // start at address $00
+   // The SevenSegmentDimmer may queue a display write from a timer interrupt
+   interruptState state = lockInterrupts();
+   pending |= what;
+   unlockInterrupts(state);
+}
+//----------------------------------------------------------
 
-   for (uint8_t i = 0; i < displaybufSize; i++)
+void ht16k33::clearPending(uint8_t what)
+{
+   interruptState state = lockInterrupts();
+   pending &= ~what;
+   unlockInterrupts(state);
+}
+//----------------------------------------------------------
+
+ht16k33::interruptState ht16k33::lockInterrupts()
+{
+   // Interrupts off, unlockInterrupts() puts back what was there, so this can be used inside an interrupt routine
+#if defined(__AVR__)
+   interruptState state = SREG;
+   cli();
+#elif defined(__arm__)
+   interruptState state = __get_PRIMASK();
+   __disable_irq();
+#elif defined(ESP8266)
+   interruptState state = xt_rsil(15);
+#else
+   interruptState state = 0;   // Unknown core: only safe outside interrupt routines
+   noInterrupts();
+#endif
+   return state;
+}
+//----------------------------------------------------------
+
+void ht16k33::unlockInterrupts(interruptState state)
+{
+#if defined(__AVR__)
+   SREG = state;
+#elif defined(__arm__)
+   __set_PRIMASK(state);
+#elif defined(ESP8266)
+   xt_wsr_ps(state);
+#else
+   (void)state;
+   interrupts();
+#endif
+}
+//----------------------------------------------------------
+
+bool ht16k33::writeBytes(const uint8_t *data, uint8_t n)
+{
+   uint32_t start = transactionStart();
+   return record(bus->write(i2c_address, data, n), n, start);
+}
+//----------------------------------------------------------
+
+bool ht16k33::record(uint8_t status, uint8_t bytes, uint32_t start)
+{
+#ifdef HT16K33_BUS_STATS
+   uint32_t time = micros() - start;
+
+   statistics.transactions++;
+   statistics.bytes     += bytes;
+   statistics.totalTime += time;
+   if (time > statistics.maxTime)   statistics.maxTime = (time > 0xFFFF) ? 0xFFFF : time;
+
+   switch (status)
    {
-      Wire.write(displaybuffer[i] & 0x00FF);
-      Wire.write(displaybuffer[i] >> 8);
+      case ht16k33Bus::busOK:        break;
+      case ht16k33Bus::busNack:      statistics.nacks++;      break;
+      case ht16k33Bus::busTimeout:   statistics.timeouts++;   break;
+      default:                       statistics.errors++;
    }
-   Wire.endTransmission();  
+#else
+   (void)bytes;
+   (void)start;
+#endif
+
+   if (status == ht16k33Bus::busOK)
+   {
+      failures = 0;
+      return true;
+   }
+
+   // Give up on the display for a while after too many failures in a row
+   if (failures < 0xFF)   failures++;
+   if (failures == maxFailures)   retryTime = millis() + (minBackoff << backoffShift);
+   return false;
+}
+//----------------------------------------------------------
+
+bool ht16k33::restart()
+{
+   uint32_t now = millis();
+
+   if ((int32_t)(now - retryTime) < 0)   return false;
+   if (!writeByte(standby ? cmd_turnOff : cmd_turnOn))
+   {
+      if (backoffShift < maxBackoffShift)   backoffShift++;
+      retryTime = now + (minBackoff << backoffShift);
+      return false;
+   }
+
+   // The HT16K33 may have been reset: send all settings and the whole display RAM again
+   backoffShift = 0;
+#ifdef HT16K33_BUS_STATS
+   statistics.restarts++;
+#endif
+   invalidateDisplay();
+   setPending(allSettings());
+   return true;
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33::allSettings()
+{
+   // Everything the HT16K33 forgets in a reset
+   return pendingSetup | pendingBrightness | pendingDisplay | (keySetup ? pendingKeys : 0x00);
+}
+//----------------------------------------------------------
+
+bool ht16k33::byteUsed(uint8_t addr)
+{
+   if ((addr >> 1) >= displayRows)   return false;
+   return !(packedBuffer && (addr & 0x01));
+}
+//----------------------------------------------------------
+
+bool ht16k33::byteDue(uint8_t addr, bool queuedOnly)
+{
+   uint16_t mask = (1u << addr);
+
+   if (!byteUsed(addr))   return false;
+   if (queuedOnly)        return queuedMask & mask;
+   return (queuedMask & mask) || (staleMask & mask) || (bufferByte(addr, blankRows) != chipbuffer[packedBuffer ? addr >> 1 : addr]);
+}
+//----------------------------------------------------------
+
+bool ht16k33::nextRange(uint8_t &first, uint8_t &last, uint8_t maxLength, bool queuedOnly)
+{
+   uint8_t addr = 0;
+   uint8_t gap  = queuedOnly ? 0 : maxGap;  // Bridging would send changes that are not queued
+
+   // Find the first byte that needs to be sent
+   while ((addr < displayRamSize) && !byteDue(addr, queuedOnly))   addr++;
+   if (addr >= displayRamSize)   return false;
+
+   // Extend the range as long as the next change is close enough
+   first = last = addr;
+   for (addr++; (addr < displayRamSize) && (addr - first < maxLength) && (addr - last <= gap + 1); addr++)
+      if (byteDue(addr, queuedOnly))   last = addr;
+   return true;
+}
+//----------------------------------------------------------
+
+void ht16k33::sendRange(uint8_t first, uint8_t last)
+{
+   uint8_t data[displayRamSize + 1];
+   uint8_t n;
+
+#ifdef HT16K33_ISR_INDICATORS
+   // Read again if an interrupt changed the overlay meanwhile. The counter only has to tell apart the
+   // changes during one read, so wrapping around is harmless
+   uint8_t seq;
+   do
+   {
+      seq = overlaySeq;
+      n   = readRange(data, first, last);
+   } while ((seq & 0x01) || (seq != overlaySeq));
+#else
+   n = readRange(data, first, last);
+#endif
+
+   for (uint8_t addr = first; addr <= last; addr++)
+   {
+      queuedMask &= ~(1u << addr);
+      staleMask  &= ~(1u << addr);
+   }
+   if (!writeBytes(data, n))
+      for (uint8_t addr = first; addr <= last; addr++)   staleMask |= (1u << addr);  // Unknown now
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33::readRange(uint8_t *data, uint8_t first, uint8_t last)
+{
+   // The start address and the bytes first..last, which become the new copy of the display RAM.
+   // One copy of blankRows for the whole range: the dimmer may change it from an interrupt, and
+   // then queues a display write that sends the rows that differ
+   uint8_t n     = 0;
+   uint8_t blank = blankRows;
+
+   data[n++] = first;
+   for (uint8_t addr = first; addr <= last; addr++)
+   {
+      uint8_t b = bufferByte(addr, blank);
+
+      if (byteUsed(addr))   chipbuffer[packedBuffer ? addr >> 1 : addr] = b;
+      data[n++] = b;
+   }
+   return n;
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33::bufferByte(uint8_t addr, uint8_t blank)
+{
+   if (blank & (1 << (addr >> 1)))       return 0x00;
+   if (addr & 0x01)                      return displaybuffer[addr >> 1] >> 8;
+#ifdef HT16K33_ISR_INDICATORS
+   return (displaybuffer[addr >> 1] & 0x00FF) | overlay[addr >> 1];
+#else
+   return displaybuffer[addr >> 1] & 0x00FF;
+#endif
 }
 
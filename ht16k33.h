@@ -19,16 +19,86 @@
  *  It is not intended to be used directly, but can be used as a base class for display types, like here a 7-segment display
  *
  *  begin() or begin(displayAddress)
- *     initialize the display: clear the diplay, set maximum brighness, no blinking
+ *     initialize the display: clear the diplay (and the back buffer), set maximum brighness, no blinking
  *  clearDisplay()
- * 	   clear the whole display buffer, including the colon. Note that only the buffer is cleared
+ * 	   clear the whole display buffer, including the colon. Note that only the buffer is cleared, call writeDisplay() to show it
  *  setDisplayStatus(s)
  *     turn the display on or off, you can use the constants ht16k33::displayOn and ht16k33::displayOff
  *  setBlinkRate(br)
  *     set the display blinkrate: ht16k33::blink_Off, ht16k33::blink_2Hz, ht16k33::blink_1Hz or ht16k33::blink_0_5Hz
  *     for no blinking, 2Hz, 1Hz or 0.5Hz
+ *  blinkRate()
+ *     the blink rate set with setBlinkRate()
  *  setBrightness(b)
  *     set the display brightness, from ht16k33::minBrightness to ht16k33::maxBrightness
+ *  writeDisplay()
+ *     write the changes in the display buffer to the display
+ *  setBlankRows(rows)
+ *     rows is a bit mask of display buffer entries that are written as empty, without changing the buffer.
+ *     Only the rows that change are written. Used to dim digits, see SevenSegmentDimmer.h
+ *
+ *  Double buffering
+ *  setBackBuffer(buffer)
+ *     draw into 'buffer' (ht16k33::bufferRow[ht16k33::bufferSize]) instead of the buffer that is sent to the display,
+ *     so a half drawn frame never reaches the display. Use nullptr to go back to a single buffer.
+ *  present(keep = false)
+ *     swap the buffers and write the new frame to the display. Afterwards the back buffer holds the
+ *     frame before, use keep = true to copy the new frame into it instead, so drawing can continue.
+ *     Without a back buffer present() is the same as writeDisplay()
+ *
+ *  Asynchronous mode
+ *  setAsync(async)
+ *     in asynchronous mode the display write and the display control functions return at once, the
+ *     update is queued and sent by service(). A newer update replaces an older one still waiting.
+ *  service(maxBytes = 17)
+ *     send at most one queued I2C transaction of at most maxBytes bytes (register address included).
+ *     Returns the number of bytes sent, 0 when there was nothing to send. Call it from loop().
+ *  busy()
+ *     true as long as there are queued updates
+ *
+ *  Bus
+ *  setBus(bus)
+ *     send all I2C traffic through 'bus' instead of Wire, call it before begin(). See ht16k33Bus.h for
+ *     other TwoWire objects (Wire1), a faster bus clock, software I2C and a transaction log
+ *  stats()
+ *     the bus statistics of this display (ht16k33::busStats): transactions, bytes (without the device
+ *     address), NACKs, timeouts, other errors, restarts and the longest and average transaction time in us.
+ *     Only with the build flag HT16K33_BUS_STATS, they take 22 bytes of RAM per display
+ *  resetStats()
+ *     set all statistics to 0, also only with HT16K33_BUS_STATS
+ *  online()
+ *     false after ht16k33::maxFailures failed transactions in a row. The display is then left alone, except
+ *     for an attempt to restart it every 100 ms, doubling up to 6.4 s. After a restart the brightness, blink
+ *     rate, display status, key setting (see ht16k33Keys.h) and display buffer are sent again. The attempts are made by service(), so in
+ *     synchronous mode at the next write
+ *  scrub(bytes = ht16k33::scrubBytes)
+ *     read the next 'bytes' bytes of the display RAM back and compare them with what was sent. Wrong bytes
+ *     are sent again, together with the oscillator, display setup, brightness and key registers, which a supply
+ *     dip may have reset as well. Every call checks the next slice, wrapping around at the end of the rows
+ *     in use. Returns false if something was repaired or the read failed. One call takes about 1 ms at
+ *     100 kHz: called every 100 ms it checks all of a 4 digit display every 0.3 s for 1% of the bus time
+ *
+ *  Interrupts
+ *   Defining HT16K33_ISR_INDICATORS as a build flag lets display types offer indicators (like the colon
+ *   and dots of SevenSegment) that may be changed from an interrupt routine. They are kept apart from the
+ *   display buffer and added to it when it is sent, which takes 10 bytes of RAM per display.
+ *   A sequence counter, made odd during a change, lets the sending code detect that an interrupt changed
+ *   the indicators while it was reading them and read them again, so interrupts are never disabled and
+ *   never wait for I2C. Only one interrupt routine may change them, and the main code never.
+ *   service() notices the change, so call service() from loop(), also in synchronous mode.
+ *
+ *  The driver keeps a copy of what the HT16K33 display RAM holds. writeDisplay() compares the
+ *  display buffer against that copy and only sends the bytes that changed, bridging short gaps
+ *  of unchanged bytes when that is cheaper than starting a new I2C transaction.
+ *  Display types set displayRows to the number of rows (display buffer entries) they use, the rows
+ *  after those are never sent.
+ *
+ *  Defining HT16K33_PACKED_BUFFER as a build flag keeps only ROW0..ROW7 (the low byte) of each row,
+ *  which is all a 7-segment backpack uses. The display buffer and the copy of the display RAM
+ *  then take 8 bytes each instead of 16. The unused (odd) bytes are never compared or sent on their own,
+ *  but a write of several rows in one transaction sends them as 0, as the HT16K33 address steps through
+ *  every byte. Splitting the write around them would cost a start, address and register byte each.
+ *  See examples/size_report for the flash and RAM this saves.
  *
  *
  * This program is free software: you can redistribute it and/or modify
@@ -52,6 +122,7 @@
 #define HT16K33_H
 
 #include <Wire.h>
+#include <ht16k33Bus.h>
 
 
 class ht16k33
@@ -68,34 +139,170 @@ class ht16k33
       static const uint8_t blink_1Hz      = 0x02;  // 1 Hz
       static const uint8_t blink_0_5Hz    = 0x03;  // 0.5 Hz
 
+      static const uint8_t bufferSize     = 0x08;
+      static const uint8_t maxFailures    = 0x03;
+      static const uint8_t scrubBytes     = 0x04;
+#ifdef HT16K33_PACKED_BUFFER
+      typedef uint8_t  bufferRow;  // ROW0..ROW7 only
+#else
+      typedef uint16_t bufferRow;
+#endif
+
+#ifdef HT16K33_BUS_STATS
+      struct busStats
+      {
+         uint32_t transactions;
+         uint32_t bytes;
+         uint16_t nacks;
+         uint16_t timeouts;
+         uint16_t errors;
+         uint16_t restarts;
+         uint16_t maxTime;     // us
+         uint32_t totalTime;   // us
+
+         uint16_t averageTime() const { return transactions ? totalTime / transactions : 0; }
+      };
+#endif
+
       ht16k33(uint8_t i2c_addr = defaultI2C_address);
 
       void begin();
       void begin(uint8_t i2c_addr);
       void setDisplayStatus(uint8_t s);
       void setBlinkRate(uint8_t br);
+      uint8_t blinkRate();
       void setBrightness(uint8_t b);
       void clearDisplay();
 
+      void setBus(ht16k33Bus &bus);
+#ifdef HT16K33_BUS_STATS
+      const busStats &stats();
+      void resetStats();
+#endif
+      bool online();
+      bool scrub(uint8_t bytes = scrubBytes);
+
+      void setBackBuffer(bufferRow *buffer);
+      void present(bool keep = false);
+
+      void    setAsync(bool async);
+      uint8_t service(uint8_t maxBytes = displayRamSize + 1);
+      bool    busy();
+
+      void writeDisplay();
+      void setBlankRows(uint8_t rows);
+
    protected:
       static const uint8_t defaultI2C_address = 0x70;
-      static const uint8_t displaybufSize = 0x08;
+      static const uint8_t displaybufSize = bufferSize;
+      static const uint8_t displayRamSize = displaybufSize * 2;  // in bytes
 
-      uint16_t displaybuffer[displaybufSize]; 
+      bufferRow  framebuffer[displaybufSize];
+      bufferRow *displaybuffer = framebuffer;  // Front buffer, sent to the display
+      bufferRow *drawbuffer    = framebuffer;  // Back buffer, the draw functions work on this one
+      uint8_t    displayRows   = bufferSize;   // Rows in use, the others are never sent
 
       uint8_t i2c_address   = defaultI2C_address;
-      uint8_t blinkRate     = blink_Off;
+      uint8_t blinkSetup    = blink_Off;  // Blink rate as sent in the display setup command
       uint8_t displayStatus = displayOff;
+      uint8_t brightness    = maxBrightness;
 
-      void writeByte(uint8_t b);
-      void writeDisplay();
+      ht16k33Bus *bus = &defaultBus;
+
+      bool writeByte(uint8_t b);
+      bool readBytes(uint8_t addr, uint8_t *data, uint8_t n);
+      void writeRange(uint8_t first, uint8_t last);
+      void invalidateDisplay();
+
+#ifdef HT16K33_ISR_INDICATORS
+      // Interrupt safe indicators, one writer only
+      void overlayWrite(uint8_t row, uint8_t mask, uint8_t bits);
+      void overlayToggle(uint8_t row, uint8_t mask);
+#endif
 
    private:
+      friend class ht16k33Keys;
+      friend class ht16k33Power;
+
+      static ht16k33TwoWire defaultBus;  // Wire, shared by all displays without a bus of their own
+
       static const uint8_t cmd_turnOff      = 0x20;  // Oscillator off, standby mode
       static const uint8_t cmd_turnOn       = 0x21;  // Oscillator on
       static const uint8_t cmd_displaySetup = 0x80;
       static const uint8_t cmd_brightness   = 0xE0;
 
+      // Unchanged bytes between two changed ones are resent rather than starting a new
+      // transaction, as long as the gap is not longer than this
+      static const uint8_t maxGap = 0x02;
+
+      // Restart attempts after maxFailures, the interval doubles after each failed attempt
+      static const uint16_t minBackoff      = 100;  // ms
+      static const uint8_t  maxBackoffShift = 6;    // Up to 100 << 6 = 6400 ms
+
+      // The interrupt enable state saved by lockInterrupts(): SREG on AVR, PRIMASK on ARM, PS on ESP8266
+#if defined(__AVR__)
+      typedef uint8_t  interruptState;
+#else
+      typedef uint32_t interruptState;
+#endif
+
+      // Queued updates
+      static const uint8_t pendingSetup      = 0x01;
+      static const uint8_t pendingBrightness = 0x02;
+      static const uint8_t pendingDisplay    = 0x04;
+      static const uint8_t pendingRange      = 0x08;  // Only the bytes queued by writeRange()
+      static const uint8_t pendingKeys       = 0x10;  // The ROW/INT setting of ht16k33Keys
+
+      // With a packed buffer only the even (low) display RAM bytes are used
+      static const bool    packedBuffer  = (sizeof(bufferRow) == 1);
+      static const uint8_t chipbufSize   = packedBuffer ? displaybufSize : displayRamSize;
+
+      uint8_t  chipbuffer[chipbufSize];     // Copy of the HT16K33 display RAM
+      uint16_t staleMask  = 0xFFFF;         // Display RAM bytes with unknown contents, 1 bit per byte
+      uint16_t queuedMask = 0x0000;         // Display RAM bytes to send even if unchanged
+      volatile uint8_t pending   = 0x00;    // Also set from an interrupt by the dimmer, see setPending()
+      volatile uint8_t blankRows = 0x00;    // Rows sent as empty
+      bool     asyncMode  = false;
+
+#ifdef HT16K33_BUS_STATS
+      busStats statistics = {};
+#endif
+      uint8_t  failures     = 0;              // Failed transactions in a row
+      uint8_t  backoffShift = 0;              // The restart interval is minBackoff << backoffShift
+      uint32_t retryTime    = 0;
+      uint8_t  scrubAddr  = 0;                // Next display RAM byte to check
+      bool     standby    = false;            // Oscillator off, see ht16k33Power
+      uint8_t  begins     = 0;                // Calls of begin(), lets ht16k33Power notice a reset
+      uint8_t  keySetup   = 0x00;             // ROW/INT set command of ht16k33Keys, 0 without keys
+
+#ifdef HT16K33_ISR_INDICATORS
+      // Indicators set from an interrupt, ORed into the low byte of each row when sent
+      volatile uint8_t overlay[displaybufSize] = {};
+      volatile uint8_t overlaySeq   = 0;      // Odd while the overlay is being changed
+      volatile bool    overlayDirty = false;  // Changed since service() last looked
+#endif
+
+      void    queue(uint8_t what);
+      void    setPending(uint8_t what);
+      void    clearPending(uint8_t what);
+      static interruptState lockInterrupts();
+      static void           unlockInterrupts(interruptState state);
+      bool    writeBytes(const uint8_t *data, uint8_t n);
+      bool    record(uint8_t status, uint8_t bytes, uint32_t start);
+#ifdef HT16K33_BUS_STATS
+      static uint32_t transactionStart()   { return micros(); }
+#else
+      static uint32_t transactionStart()   { return 0; }   // Not timed without statistics
+#endif
+      bool    restart();
+      uint8_t allSettings();
+      bool    byteUsed(uint8_t addr);
+      bool    byteDue(uint8_t addr, bool queuedOnly);
+      bool    nextRange(uint8_t &first, uint8_t &last, uint8_t maxLength, bool queuedOnly);
+      void    sendRange(uint8_t first, uint8_t last);
+      uint8_t readRange(uint8_t *data, uint8_t first, uint8_t last);
+      uint8_t bufferByte(uint8_t addr, uint8_t blank);
+
 };
 
 #endif // HT16K33_H
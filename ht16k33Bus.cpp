@@ -0,0 +1,342 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         ht16k33Bus.cpp
+ * Description:  I2C transports for the HT16K33 driver
+ *
+ * This file is part of SevenSegment
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#include "ht16k33Bus.h"
+
+
+//****************
+// ht16k33TwoWire
+//****************
+
+ht16k33TwoWire::ht16k33TwoWire(TwoWire &w, uint32_t c)
+   : wire(w), clock(c)
+{
+}
+//----------------------------------------------------------
+
+void ht16k33TwoWire::begin()
+{
+   wire.begin();
+   if (clock)   wire.setClock(clock);  // begin() may reset the clock, set it afterwards
+}
+//----------------------------------------------------------
+
+void ht16k33TwoWire::setClock(uint32_t c)
+{
+   clock = c;
+   if (clock)   wire.setClock(clock);
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33TwoWire::write(uint8_t address, const uint8_t *data, uint8_t n)
+{
+   wire.beginTransmission(address);
+   for (uint8_t i = 0; i < n; i++)   wire.write(data[i]);
+   return status(wire.endTransmission());
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33TwoWire::read(uint8_t address, uint8_t reg, uint8_t *data, uint8_t n)
+{
+   // Set the address pointer, then read from there
+   wire.beginTransmission(address);
+   wire.write(reg);
+
+   uint8_t result = status(wire.endTransmission());
+   if (result != busOK)   return result;
+
+   if (wire.requestFrom(address, n) != n)   return busNack;
+   for (uint8_t i = 0; i < n; i++)   data[i] = wire.read();
+   return busOK;
+}
+//----------------------------------------------------------
+
+
+//*********
+// private
+//*********
+
+uint8_t ht16k33TwoWire::status(uint8_t result)
+{
+   // Wire.endTransmission(): 2 and 3 are a NACK on the address or on the data, 5 is a timeout
+   switch (result)
+   {
+      case 0:   return busOK;
+      case 2:
+      case 3:   return busNack;
+      case 5:   return busTimeout;
+   }
+   return busError;
+}
+//----------------------------------------------------------
+
+
+//****************
+// ht16k33SoftI2C
+//****************
+
+ht16k33SoftI2C::ht16k33SoftI2C(uint8_t sdaPin, uint8_t sclPin, uint32_t clock)
+   : sda(sdaPin), scl(sclPin)
+{
+   setClock(clock);
+}
+//----------------------------------------------------------
+
+void ht16k33SoftI2C::begin()
+{
+   release(sda);
+   release(scl);
+}
+//----------------------------------------------------------
+
+void ht16k33SoftI2C::setClock(uint32_t clock)
+{
+   if (clock == 0)   clock = 100000;
+   halfPeriod = 500000 / clock;
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33SoftI2C::write(uint8_t address, const uint8_t *data, uint8_t n)
+{
+   if (!start())   return busTimeout;
+
+   uint8_t result = writeByte(address << 1);
+   for (uint8_t i = 0; (result == busOK) && (i < n); i++)   result = writeByte(data[i]);
+   stop();
+   return result;
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33SoftI2C::read(uint8_t address, uint8_t reg, uint8_t *data, uint8_t n)
+{
+   // Set the address pointer, then a repeated start to read from there
+   if (!start())   return busTimeout;
+
+   uint8_t result = writeByte(address << 1);
+   if (result == busOK)   result = writeByte(reg);
+   if (result == busOK)   result = start() ? writeByte((address << 1) | 0x01) : busTimeout;
+   for (uint8_t i = 0; (result == busOK) && (i < n); i++)   result = readByte(data[i], i + 1 < n);  // No ack after the last byte
+   stop();
+   return result;
+}
+//----------------------------------------------------------
+
+
+//*********
+// private
+//*********
+
+void ht16k33SoftI2C::release(uint8_t pin)
+{
+   pinMode(pin, INPUT);  // Open drain: the pull up resistor makes the line high
+}
+//----------------------------------------------------------
+
+void ht16k33SoftI2C::pullLow(uint8_t pin)
+{
+   digitalWrite(pin, LOW);
+   pinMode(pin, OUTPUT);
+}
+//----------------------------------------------------------
+
+bool ht16k33SoftI2C::sclHigh()
+{
+   // Wait while a device stretches the clock
+   release(scl);
+   for (uint16_t t = 0; digitalRead(scl) == LOW; t++)
+   {
+      if (t >= stretchTimeout)   return false;
+      delayMicroseconds(1);
+   }
+   delayMicroseconds(halfPeriod);
+   return true;
+}
+//----------------------------------------------------------
+
+bool ht16k33SoftI2C::start()
+{
+   // SDA goes low while SCL is high, also used as a repeated start
+   release(sda);
+   delayMicroseconds(halfPeriod);
+   if (!sclHigh())   return false;
+   pullLow(sda);
+   delayMicroseconds(halfPeriod);
+   pullLow(scl);
+   return true;
+}
+//----------------------------------------------------------
+
+void ht16k33SoftI2C::stop()
+{
+   // SDA goes high while SCL is high
+   pullLow(sda);
+   delayMicroseconds(halfPeriod);
+   sclHigh();
+   release(sda);
+   delayMicroseconds(halfPeriod);
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33SoftI2C::writeByte(uint8_t b)
+{
+   for (uint8_t bit = 0; bit < 8; bit++, b <<= 1)
+   {
+      if (b & 0x80)
+         release(sda);
+      else
+         pullLow(sda);
+      delayMicroseconds(halfPeriod);
+      if (!sclHigh())   return busTimeout;
+      pullLow(scl);
+   }
+
+   // The device pulls SDA low to acknowledge
+   release(sda);
+   delayMicroseconds(halfPeriod);
+   if (!sclHigh())   return busTimeout;
+   bool ack = (digitalRead(sda) == LOW);
+   pullLow(scl);
+   return ack ? busOK : busNack;
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33SoftI2C::readByte(uint8_t &b, bool ack)
+{
+   b = 0x00;
+
+   release(sda);
+   for (uint8_t bit = 0; bit < 8; bit++)
+   {
+      delayMicroseconds(halfPeriod);
+      if (!sclHigh())   return busTimeout;
+      b = (b << 1) | (digitalRead(sda) == HIGH);
+      pullLow(scl);
+   }
+
+   if (ack)   pullLow(sda);
+   delayMicroseconds(halfPeriod);
+   bool stretched = !sclHigh();
+   pullLow(scl);
+   release(sda);
+   return stretched ? busTimeout : busOK;
+}
+//----------------------------------------------------------
+
+
+//*****************
+// ht16k33BusTrace
+//*****************
+
+ht16k33BusTrace::ht16k33BusTrace(Print &l, ht16k33Bus *b)
+   : log(l), bus(b)
+{
+}
+//----------------------------------------------------------
+
+void ht16k33BusTrace::begin()
+{
+   if (bus)   bus->begin();
+}
+//----------------------------------------------------------
+
+void ht16k33BusTrace::setClock(uint32_t clock)
+{
+   if (bus)   bus->setClock(clock);
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33BusTrace::write(uint8_t address, const uint8_t *data, uint8_t n)
+{
+   uint32_t start  = micros();
+   uint8_t  result = bus ? bus->write(address, data, n) : busOK;
+
+   logStart(start, 'W', address);
+   for (uint8_t i = 0; i < n; i++)   logByte(data[i]);
+   logEnd(result);
+   return result;
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33BusTrace::read(uint8_t address, uint8_t reg, uint8_t *data, uint8_t n)
+{
+   uint32_t start  = micros();
+   uint8_t  result = busOK;
+
+   if (bus)
+      result = bus->read(address, reg, data, n);
+   else
+      for (uint8_t i = 0; i < n; i++)   data[i] = 0x00;
+
+   logStart(start, 'R', address);
+   logByte(reg);
+   log.print(" :");
+   if (result == busOK)
+      for (uint8_t i = 0; i < n; i++)   logByte(data[i]);
+   logEnd(result);
+   return result;
+}
+//----------------------------------------------------------
+
+
+//*********
+// private
+//*********
+
+void ht16k33BusTrace::logStart(uint32_t start, char type, uint8_t address)
+{
+   log.print((unsigned long)start);
+   log.print(' ');
+   log.print((unsigned long)(micros() - start));
+   log.print(' ');
+   log.print(type);
+   logByte(address);
+}
+//----------------------------------------------------------
+
+void ht16k33BusTrace::logByte(uint8_t b)
+{
+   log.print(' ');
+   if (b < 0x10)   log.print('0');
+   log.print((unsigned long)b, HEX);
+}
+//----------------------------------------------------------
+
+void ht16k33BusTrace::logEnd(uint8_t status)
+{
+   switch (status)
+   {
+      case busNack:      log.print(" NACK");      break;
+      case busTimeout:   log.print(" TIMEOUT");   break;
+      case busError:     log.print(" ERROR");     break;
+   }
+   log.println();
+}
+//----------------------------------------------------------
@@ -0,0 +1,150 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         ht16k33Bus.h
+ * Description:  I2C transports for the HT16K33 driver
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage
+ *  ht16k33 sends every I2C transaction through an ht16k33Bus. Without setBus() it uses a shared
+ *  ht16k33TwoWire on Wire. A bus can be shared by several displays.
+ *
+ *  ht16k33TwoWire bus = ht16k33TwoWire(wire = Wire, clock = 0)
+ *     any TwoWire object, for example Wire1. begin() sets the clock in Hz, 0 leaves the clock of the
+ *     Wire library (100 kHz). The HT16K33 supports 400 kHz (Fast-mode)
+ *  ht16k33SoftI2C bus = ht16k33SoftI2C(sdaPin, sclPin, clock = 100000)
+ *     I2C on any 2 pins, the bus needs pull up resistors. The clock is an upper limit: at high clock
+ *     rates the speed of digitalWrite() limits the rate
+ *  ht16k33BusTrace bus = ht16k33BusTrace(log, bus = nullptr)
+ *     write a line to 'log' (any Print, for example Serial) for each transaction, then pass it on to 'bus':
+ *        <start time in us> <duration in us> W <address> <bytes>          for a write
+ *        <start time in us> <duration in us> R <address> <register> : <bytes>   for a read
+ *     all numbers except the times in hexadecimal, followed by " NACK", " TIMEOUT" or " ERROR" if the transaction failed.
+ *     Without 'bus' every transaction succeeds and reads return 0, so a sketch can run and be profiled
+ *     without a display, on the Arduino or in a host build
+ *
+ *  Methods of all buses, normally only called by ht16k33
+ *  begin()
+ *     initialise the bus
+ *  setClock(clock)
+ *     set the bus clock in Hz, can also be changed after begin()
+ *  write(address, data, n)
+ *     one write transaction of n bytes
+ *  read(address, reg, data, n)
+ *     set the register pointer to 'reg' and read n bytes
+ *  Both return ht16k33Bus::busOK, or busNack if the device didn't acknowledge, busTimeout if the bus hung
+ *  and busError for any other failure
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#ifndef HT16K33BUS_H
+#define HT16K33BUS_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+
+class ht16k33Bus
+{
+   public:
+      static const uint8_t busOK      = 0x00;
+      static const uint8_t busNack    = 0x01;
+      static const uint8_t busTimeout = 0x02;
+      static const uint8_t busError   = 0x03;
+
+      virtual ~ht16k33Bus() {}
+
+      virtual void    begin() = 0;
+      virtual void    setClock(uint32_t clock) = 0;
+      virtual uint8_t write(uint8_t address, const uint8_t *data, uint8_t n) = 0;
+      virtual uint8_t read(uint8_t address, uint8_t reg, uint8_t *data, uint8_t n) = 0;
+};
+
+
+class ht16k33TwoWire : public ht16k33Bus
+{
+   public:
+      ht16k33TwoWire(TwoWire &wire = Wire, uint32_t clock = 0);
+
+      void    begin();
+      void    setClock(uint32_t clock);
+      uint8_t write(uint8_t address, const uint8_t *data, uint8_t n);
+      uint8_t read(uint8_t address, uint8_t reg, uint8_t *data, uint8_t n);
+
+   private:
+      TwoWire  &wire;
+      uint32_t  clock;
+
+      static uint8_t status(uint8_t result);
+};
+
+
+class ht16k33SoftI2C : public ht16k33Bus
+{
+   public:
+      ht16k33SoftI2C(uint8_t sdaPin, uint8_t sclPin, uint32_t clock = 100000);
+
+      void    begin();
+      void    setClock(uint32_t clock);
+      uint8_t write(uint8_t address, const uint8_t *data, uint8_t n);
+      uint8_t read(uint8_t address, uint8_t reg, uint8_t *data, uint8_t n);
+
+   private:
+      static const uint16_t stretchTimeout = 1000;  // us a device may hold SCL low
+
+      uint8_t  sda;
+      uint8_t  scl;
+      uint16_t halfPeriod;  // us
+
+      void    release(uint8_t pin);
+      void    pullLow(uint8_t pin);
+      bool    sclHigh();
+      bool    start();
+      void    stop();
+      uint8_t writeByte(uint8_t b);
+      uint8_t readByte(uint8_t &b, bool ack);
+};
+
+
+class ht16k33BusTrace : public ht16k33Bus
+{
+   public:
+      ht16k33BusTrace(Print &log, ht16k33Bus *bus = nullptr);
+
+      void    begin();
+      void    setClock(uint32_t clock);
+      uint8_t write(uint8_t address, const uint8_t *data, uint8_t n);
+      uint8_t read(uint8_t address, uint8_t reg, uint8_t *data, uint8_t n);
+
+   private:
+      Print      &log;
+      ht16k33Bus *bus;
+
+      void logStart(uint32_t start, char type, uint8_t address);
+      void logByte(uint8_t b);
+      void logEnd(uint8_t status);
+};
+
+#endif // HT16K33BUS_H
@@ -0,0 +1,170 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         ht16k33Keys.cpp
+ * Description:  HT16K33 key scan driver
+ *
+ * This file is part of SevenSegment
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#include "ht16k33Keys.h"
+
+// Key RAM layout: 2 bytes per K line, KS0..KS7 in the first byte, KS8..KS12 in the low bits of the second
+static const uint8_t keyMask[] = { 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x1F };
+
+
+//********
+// public
+//********
+
+ht16k33Keys::ht16k33Keys(ht16k33 &c)
+   : chip(c)
+{
+   for (uint8_t i = 0; i < keyRamSize; i++)   stable[i] = candidate[i] = 0x00;
+}
+//----------------------------------------------------------
+
+void ht16k33Keys::begin(uint8_t pin, bool activeHigh)
+{
+   intPin   = pin;
+   intLevel = activeHigh ? HIGH : LOW;
+   if (intPin != noPin)   pinMode(intPin, activeHigh ? INPUT : INPUT_PULLUP);
+
+   // The driver sends it again after a restart, a repair by scrub() or another begin()
+   chip.keySetup = cmd_rowIntSet | rowInt_int | (activeHigh ? rowInt_actHigh : 0x00);
+   chip.queue(ht16k33::pendingKeys);
+   lastRead = millis();
+}
+//----------------------------------------------------------
+
+void ht16k33Keys::keyInterrupt()
+{
+   interrupted = true;
+}
+//----------------------------------------------------------
+
+bool ht16k33Keys::poll()
+{
+   return poll(millis());
+}
+//----------------------------------------------------------
+
+bool ht16k33Keys::poll(uint32_t now)
+{
+   // Only read the keys when the HT16K33 reports one, or while they are changing
+   if (((uint32_t)(now - lastRead) >= scanInterval) && (scanning || keyReported()))
+   {
+      uint8_t keys[keyRamSize];
+
+      lastRead    = now;
+      interrupted = false;
+      if (chip.readBytes(addr_keyRam, keys, keyRamSize))   update(keys);
+   }
+   return available() > 0;
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33Keys::available()
+{
+   return (queueHead - queueTail) & (queueSize - 1);
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33Keys::read()
+{
+   if (queueHead == queueTail)   return noKey;
+
+   uint8_t event = queue[queueTail];
+   queueTail = (queueTail + 1) & (queueSize - 1);
+   return event;
+}
+//----------------------------------------------------------
+
+bool ht16k33Keys::isPressed(uint8_t key)
+{
+   if (key >= keyRamSize * 8)   return false;
+   return stable[key >> 3] & (1 << (key & 0x07));
+}
+//----------------------------------------------------------
+
+
+//*********
+// private
+//*********
+
+bool ht16k33Keys::keyReported()
+{
+   if (interrupted)   return true;
+   if (intPin != noPin)   return digitalRead(intPin) == intLevel;
+
+   uint8_t flag;
+   return chip.readBytes(addr_intFlag, &flag, 1) && flag;
+}
+//----------------------------------------------------------
+
+void ht16k33Keys::update(const uint8_t *keys)
+{
+   bool changed = false;
+
+   for (uint8_t i = 0; i < keyRamSize; i++)
+   {
+      uint8_t k = keys[i] & keyMask[i];
+
+      if (k != candidate[i])   changed = true;
+      candidate[i] = k;
+   }
+
+   // Accept the keys once they were read the same 'debounce' times
+   if (changed)
+      sameCount = 1;
+   else if (sameCount < debounce)
+      sameCount++;
+
+   scanning = false;
+   for (uint8_t i = 0; i < keyRamSize; i++)
+   {
+      uint8_t diff = stable[i] ^ candidate[i];
+
+      if (diff && (sameCount >= debounce))
+      {
+         for (uint8_t bit = 0; bit < 8; bit++)
+            if (diff & (1 << bit))
+               addEvent((i << 3) + bit + ((candidate[i] & (1 << bit)) ? keyPressed : 0x00));
+         stable[i] = candidate[i];
+      }
+      if (candidate[i] || (stable[i] != candidate[i]))   scanning = true;
+   }
+}
+//----------------------------------------------------------
+
+void ht16k33Keys::addEvent(uint8_t event)
+{
+   uint8_t next = (queueHead + 1) & (queueSize - 1);
+
+   if (next == queueTail)   return;  // Full
+   queue[queueHead] = event;
+   queueHead = next;
+}
+//----------------------------------------------------------
@@ -0,0 +1,110 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         ht16k33Keys.h
+ * Description:  HT16K33 key scan driver
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage
+ *  The HT16K33 scans a matrix of 13 x 3 keys (KS0..KS12 x K1..K3). ht16k33Keys reads the key RAM only
+ *  when the HT16K33 reports a key, debounces the keys and keeps the press and release events in a
+ *  small queue. Key numbers are 16 * K + KS, with K from 0 (K1) to 2 (K3) and KS from 0 to 12.
+ *
+ *  Initialise with ht16k33Keys keys = ht16k33Keys(display), after display.begin() call
+ *  begin() or begin(intPin, activeHigh = false)
+ *     turn the ROW15/INT pin into the key interrupt output. Without intPin the interrupt flag register
+ *     is polled over I2C, with intPin the pin is read instead. activeHigh sets the polarity of the pin.
+ *     The display sends this setting again when it restarts (see ht16k33::online()) or is begun again
+ *  keyInterrupt()
+ *     may be called from an interrupt routine attached to intPin, the next poll() will read the keys
+ *  poll() or poll(now)
+ *     call this from loop(). Reads the keys if needed, at most once every ht16k33Keys::scanInterval ms.
+ *     Returns true if there are events. 'now' is the time in milliseconds, default millis()
+ *  available()
+ *     the number of events waiting
+ *  read()
+ *     the next event: the key number, with ht16k33Keys::keyPressed set for a press. ht16k33Keys::noKey if
+ *     there are no events. When the queue is full new events are lost.
+ *  isPressed(key)
+ *     the debounced state of a key
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#ifndef HT16K33KEYS_H
+#define HT16K33KEYS_H
+
+#include <Arduino.h>
+#include <ht16k33.h>
+
+
+class ht16k33Keys
+{
+   public:
+      static const uint8_t noPin        = 0xFF;
+      static const uint8_t noKey        = 0xFF;
+      static const uint8_t keyPressed   = 0x80;
+      static const uint8_t scanInterval = 20;   // ms, about the HT16K33 key scan period
+      static const uint8_t debounce     = 2;    // Number of equal reads before a change is accepted
+
+      ht16k33Keys(ht16k33 &chip);
+
+      void    begin(uint8_t intPin = noPin, bool activeHigh = false);
+      void    keyInterrupt();
+      bool    poll();
+      bool    poll(uint32_t now);
+      uint8_t available();
+      uint8_t read();
+      bool    isPressed(uint8_t key);
+
+   private:
+      static const uint8_t keyRamSize      = 0x06;
+      static const uint8_t queueSize       = 0x08;  // Power of 2
+      static const uint8_t addr_keyRam     = 0x40;
+      static const uint8_t addr_intFlag    = 0x60;
+      static const uint8_t cmd_rowIntSet   = 0xA0;
+      static const uint8_t rowInt_int      = 0x01;  // ROW15/INT pin is the interrupt output
+      static const uint8_t rowInt_actHigh  = 0x02;
+
+      ht16k33 &chip;
+      uint8_t  intPin   = noPin;
+      uint8_t  intLevel = LOW;
+      volatile bool interrupted = false;
+
+      uint8_t  stable[keyRamSize];       // Debounced state
+      uint8_t  candidate[keyRamSize];    // Last read state
+      uint8_t  sameCount = 0;            // Number of reads 'candidate' didn't change
+      bool     scanning  = false;        // Keys down or not yet stable, keep reading
+      uint32_t lastRead;
+
+      uint8_t  queue[queueSize];
+      uint8_t  queueHead = 0;
+      uint8_t  queueTail = 0;
+
+      bool keyReported();
+      void update(const uint8_t *keys);
+      void addEvent(uint8_t event);
+};
+
+#endif // HT16K33KEYS_H
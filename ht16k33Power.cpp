@@ -0,0 +1,179 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         ht16k33Power.cpp
+ * Description:  HT16K33 standby and idle power management
+ *
+ * This file is part of SevenSegment
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#include "ht16k33Power.h"
+
+
+//********
+// public
+//********
+
+ht16k33Power::ht16k33Power(ht16k33 &c)
+   : chip(c)
+{
+   lastUpdate = millis();
+   reset(lastUpdate);
+   for (uint8_t i = 0; i < stateCount; i++)   time[i] = 0;
+}
+//----------------------------------------------------------
+
+void ht16k33Power::setIdleTimeout(uint32_t timeout)
+{
+   idleTimeout = timeout;
+}
+//----------------------------------------------------------
+
+void ht16k33Power::setDimming(uint32_t after, uint16_t step)
+{
+   dimAfter = after;
+   dimStep  = step;
+}
+//----------------------------------------------------------
+
+void ht16k33Power::activity()
+{
+   activity(millis());
+}
+//----------------------------------------------------------
+
+void ht16k33Power::activity(uint32_t now)
+{
+   lastActivity = now;
+   if (currentState != stateOn)   update(now);
+}
+//----------------------------------------------------------
+
+void ht16k33Power::update()
+{
+   update(millis());
+}
+//----------------------------------------------------------
+
+void ht16k33Power::update(uint32_t now)
+{
+   time[currentState] += now - lastUpdate;
+   lastUpdate = now;
+
+   // begin() turned the oscillator on and set the brightness
+   if (chip.begins != chipBegins)   reset(now);
+
+   uint32_t idle = now - lastActivity;
+   uint8_t  next = stateOn;
+
+   if (frameEmpty() || (idleTimeout && (idle >= idleTimeout)))
+      next = stateStandby;
+   else if (dimStep && (idle >= dimAfter))
+      next = stateDimmed;
+
+   if (next == stateStandby)
+   {
+      // Oscillator off, the display RAM and the settings are kept
+      if (currentState != stateStandby)
+      {
+         chip.standby = true;
+         chip.writeByte(ht16k33::cmd_turnOff);
+      }
+      currentState = stateStandby;
+      return;
+   }
+
+   if (currentState == stateStandby)
+   {
+      chip.standby = false;
+      chip.writeByte(ht16k33::cmd_turnOn);
+   }
+
+   if (next == stateDimmed)
+   {
+      // Dimming starts from the brightness set last, also when that was set while dimmed
+      if (!lowered || (chip.brightness != dimmedTo))   fullBrightness = chip.brightness;
+      lowered = true;
+
+      dimmedTo = dimmedBrightness(idle);
+      if (dimmedTo != chip.brightness)   chip.setBrightness(dimmedTo);
+   }
+   else if (lowered)
+   {
+      lowered = false;
+      if ((chip.brightness == dimmedTo) && (dimmedTo != fullBrightness))   chip.setBrightness(fullBrightness);
+   }
+   currentState = next;
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33Power::state()
+{
+   return currentState;
+}
+//----------------------------------------------------------
+
+uint32_t ht16k33Power::timeIn(uint8_t s)
+{
+   return (s < stateCount) ? time[s] : 0;
+}
+//----------------------------------------------------------
+
+
+//*********
+// private
+//*********
+
+void ht16k33Power::reset(uint32_t now)
+{
+   currentState = stateOn;
+   lowered      = false;
+   lastActivity = now;
+   chipBegins   = chip.begins;
+}
+//----------------------------------------------------------
+
+bool ht16k33Power::frameEmpty()
+{
+   for (uint8_t i = 0; i < chip.displayRows; i++)
+   {
+      if (chip.displaybuffer[i])   return false;
+#ifdef HT16K33_ISR_INDICATORS
+      if (chip.overlay[i])         return false;   // Colon or dot set from an interrupt
+#endif
+   }
+   return true;
+}
+//----------------------------------------------------------
+
+uint8_t ht16k33Power::dimmedBrightness(uint32_t idle)
+{
+   // One step down at 'dimAfter', then one every 'dimStep'
+   uint32_t steps = (idle - dimAfter) / dimStep + 1;
+
+   if (steps >= fullBrightness - ht16k33::minBrightness)   return ht16k33::minBrightness;
+   return fullBrightness - steps;
+}
+//----------------------------------------------------------
@@ -0,0 +1,104 @@
+/**********************************************************************************
+ *
+ * Copyright (C) 2018
+ *               Joeri Van hoyweghen
+ *               Joserta Consulting & Engineering
+ *
+ *               All Rights Reserved
+ *
+ *
+ * Contact:      Joeri@Joserta.be
+ *
+ * File:         ht16k33Power.h
+ * Description:  HT16K33 standby and idle power management
+ *
+ * This file is part of SevenSegment
+ *
+ * Usage
+ *  ht16k33Power puts the HT16K33 in standby (oscillator and LEDs off) while the display buffer is empty,
+ *  or when there was no activity for a while. Optionally the brightness is first lowered one step at a
+ *  time. The display RAM and the settings are kept in standby and the display can still be written,
+ *  so waking up takes 1 transaction, plus 1 to restore the brightness if it was lowered.
+ *
+ *  Initialise with ht16k33Power power = ht16k33Power(display), after display.begin()
+ *  setIdleTimeout(timeout)
+ *     go to standby after 'timeout' ms without activity(), 0 (the default) to never time out
+ *  setDimming(after, step)
+ *     'after' ms without activity lower the brightness by 1 every 'step' ms, down to ht16k33::minBrightness.
+ *     step 0 (the default) turns dimming off
+ *  activity() or activity(now)
+ *     call this when the user does something, for example on a key press. Wakes the display up and
+ *     restores the brightness. Drawing on the display is no activity
+ *  A setBrightness() while dimmed becomes the brightness to return to. After display.begin() the power
+ *  state starts over as on, without activity so far
+ *  update() or update(now)
+ *     call this from loop(). Changes the power state when needed, returns at once otherwise.
+ *     'now' is the time in milliseconds, default millis()
+ *  state()
+ *     ht16k33Power::stateOn, stateDimmed or stateStandby
+ *  timeIn(state)
+ *     milliseconds spent in 'state', counted by update(). Multiply with the current of each state
+ *     to estimate the energy used
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **********************************************************************************/
+
+#ifndef HT16K33POWER_H
+#define HT16K33POWER_H
+
+#include <Arduino.h>
+#include <ht16k33.h>
+
+
+class ht16k33Power
+{
+   public:
+      static const uint8_t stateOn      = 0x00;
+      static const uint8_t stateDimmed  = 0x01;
+      static const uint8_t stateStandby = 0x02;
+
+      ht16k33Power(ht16k33 &chip);
+
+      void     setIdleTimeout(uint32_t timeout);
+      void     setDimming(uint32_t after, uint16_t step);
+      void     activity();
+      void     activity(uint32_t now);
+      void     update();
+      void     update(uint32_t now);
+      uint8_t  state();
+      uint32_t timeIn(uint8_t state);
+
+   private:
+      static const uint8_t stateCount = 0x03;
+
+      ht16k33 &chip;
+      uint8_t  currentState = stateOn;
+      bool     lowered      = false;    // The brightness was lowered by dimming
+      uint8_t  fullBrightness;          // Brightness before dimming
+      uint8_t  dimmedTo;                // Brightness last set by dimming
+      uint8_t  chipBegins;              // chip.begins when the state was last reset
+      uint32_t idleTimeout  = 0;
+      uint32_t dimAfter     = 0;
+      uint16_t dimStep      = 0;
+      uint32_t lastActivity;
+      uint32_t lastUpdate;
+      uint32_t time[stateCount];
+
+      void    reset(uint32_t now);
+      bool    frameEmpty();
+      uint8_t dimmedBrightness(uint32_t idle);
+};
+
+#endif // HT16K33POWER_H